@@ -12,6 +12,7 @@ public class FTXUI : ModuleRules
 		bEnableUndefinedIdentifierWarnings = false;
 		ModuleIncludePathWarningLevel = WarningLevel.Warning;
 		bWarningsAsErrors = false;
+		CppStandard = CppStandardVersion.Cpp20;
 		
 		PublicIncludePaths.Add(Path.Combine(ModuleDirectory, "Public"));
 		PublicIncludePaths.Add(Path.Combine(ModuleDirectory, "Private"));
@@ -117,8 +117,12 @@ class ButtonBase : public ComponentBase, public ButtonOption {
   }
 
   bool OnMouseEvent(Event event) {
-    mouse_hover_ =
+    const bool hover =
         box_.Contain(event.mouse().x, event.mouse().y) && CaptureMouse(event);
+    if (hover != mouse_hover_) {
+      mouse_hover_ = hover;
+      Invalidate(event);
+    }
 
     if (!mouse_hover_) {
       return false;
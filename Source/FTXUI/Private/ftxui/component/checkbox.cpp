@@ -48,7 +48,7 @@ class CheckboxBase : public ComponentBase, public CheckboxOption {
       return OnMouseEvent(event);
     }
 
-    hovered_ = false;
+    SetHovered(event, false);
     if (event == Event::Character(' ') || event == Event::Return) {
       *checked = !*checked;
       on_change();
@@ -59,7 +59,7 @@ class CheckboxBase : public ComponentBase, public CheckboxOption {
   }
 
   bool OnMouseEvent(Event event) {
-    hovered_ = box_.Contain(event.mouse().x, event.mouse().y);
+    SetHovered(event, box_.Contain(event.mouse().x, event.mouse().y));
 
     if (!CaptureMouse(event)) {
       return false;
@@ -79,6 +79,13 @@ class CheckboxBase : public ComponentBase, public CheckboxOption {
     return false;
   }
 
+  void SetHovered(const Event& event, bool hovered) {
+    if (hovered != hovered_) {
+      hovered_ = hovered;
+      Invalidate(event);
+    }
+  }
+
   bool Focusable() const final { return true; }
 
   bool hovered_ = false;
@@ -181,11 +181,18 @@ void ComponentBase::SetActiveChild(Component child) {  // NOLINT
 /// @brief Configure all the ancestors to give focus to this component.
 /// @ingroup component
 void ComponentBase::TakeFocus() {
+  bool changed = false;
   ComponentBase* child = this;
   while (ComponentBase* parent = child->parent_) {
+    changed |= parent->ActiveChild().get() != child;
     parent->SetActiveChild(child);
     child = parent;
   }
+  if (changed) {
+    if (auto* screen = ScreenInteractive::Active()) {
+      screen->Invalidate();
+    }
+  }
 }
 
 /// @brief Take the CapturedMouse if available. There is only one component of
@@ -199,4 +206,14 @@ CapturedMouse ComponentBase::CaptureMouse(const Event& event) {  // NOLINT
   return std::make_unique<CaptureMouseImpl>();
 }
 
+/// @brief Request a new frame, because the component changed while handling
+/// |event|, without handling it. For instance, when the mouse hovers it.
+/// @param event The event
+/// @ingroup component
+void ComponentBase::Invalidate(const Event& event) {  // NOLINT
+  if (event.screen_) {
+    event.screen_->Invalidate();
+  }
+}
+
 }  // namespace ftxui
@@ -0,0 +1,114 @@
+// Copyright 2023 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include "ftxui/component/coroutine.hpp"
+
+#include <array>    // for array
+#include <new>      // for operator new, operator delete
+#include <utility>  // for move
+
+#include "ftxui/component/screen_interactive.hpp"  // for ScreenInteractive
+
+namespace ftxui {
+
+namespace {
+
+// The frames are rounded up to a multiple of |kFrameGranularity|. The larger
+// ones are not pooled.
+constexpr size_t kFrameGranularity = 64;
+constexpr size_t kFrameClasses = 32;
+
+// The free blocks of every size, linked through their first bytes. Blocks
+// freed by a thread are reused by the same thread.
+class FramePool {
+ public:
+  FramePool() = default;
+  FramePool(const FramePool&) = delete;
+  FramePool& operator=(const FramePool&) = delete;
+  ~FramePool() {
+    for (FreeBlock* block : free_) {
+      while (block) {
+        FreeBlock* next = block->next;
+        ::operator delete(block);
+        block = next;
+      }
+    }
+  }
+
+  void* Allocate(size_t size) {
+    const size_t index = ClassOf(size);
+    if (index >= kFrameClasses) {
+      return ::operator new(size);
+    }
+    if (FreeBlock* block = free_[index]) {
+      free_[index] = block->next;
+      return block;
+    }
+    return ::operator new((index + 1) * kFrameGranularity);
+  }
+
+  void Free(void* frame, size_t size) {
+    const size_t index = ClassOf(size);
+    if (index >= kFrameClasses) {
+      ::operator delete(frame);
+      return;
+    }
+    auto* block = static_cast<FreeBlock*>(frame);
+    block->next = free_[index];
+    free_[index] = block;
+  }
+
+ private:
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+
+  static size_t ClassOf(size_t size) {
+    return (size + kFrameGranularity - 1) / kFrameGranularity - 1;
+  }
+
+  std::array<FreeBlock*, kFrameClasses> free_ = {};
+};
+
+FramePool& GetFramePool() {
+  thread_local FramePool pool;
+  return pool;
+}
+
+}  // namespace
+
+/// @brief Allocate the frame of a coroutine.
+/// @param size The size of the frame, in bytes.
+/// @ingroup component
+void* AllocateCoroutineFrame(size_t size) {
+  return GetFramePool().Allocate(size);
+}
+
+/// @brief Free a frame allocated by AllocateCoroutineFrame.
+/// @param frame The frame.
+/// @param size The size given to AllocateCoroutineFrame.
+/// @ingroup component
+void FreeCoroutineFrame(void* frame, size_t size) {
+  GetFramePool().Free(frame, size);
+}
+
+void NextFrameAwaiter::await_suspend(std::coroutine_handle<> handle) {
+  screen_->frame_waiters_.push_back(handle);
+  screen_->Invalidate();
+}
+
+void SleepAwaiter::await_suspend(std::coroutine_handle<> handle) {
+  screen_->SetTimeout(
+      [screen = screen_, coroutine = SuspendedCoroutine(handle)]() mutable {
+        coroutine();
+        screen->Invalidate();
+      },
+      duration_);
+}
+
+void NextEventAwaiter::await_suspend(std::coroutine_handle<> handle) {
+  handle_ = handle;
+  screen_->event_waiters_.push_back(this);
+}
+
+}  // namespace ftxui
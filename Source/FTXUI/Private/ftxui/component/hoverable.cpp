@@ -17,9 +17,13 @@ namespace ftxui {
 
 namespace {
 
+// Run |f| on the main loop, and draw its effects.
 void Post(std::function<void()> f) {
   if (auto* screen = ScreenInteractive::Active()) {
-    screen->Post(std::move(f));
+    screen->Post([screen, f = std::move(f)] {
+      f();
+      screen->Invalidate();
+    });
     return;
   }
   f();
@@ -56,8 +60,12 @@ Component Hoverable(Component component, bool* hover) {
 
     bool OnEvent(Event event) override {
       if (event.is_mouse()) {
-        *hover_ = box_.Contain(event.mouse().x, event.mouse().y) &&
-                  CaptureMouse(event);
+        const bool hover = box_.Contain(event.mouse().x, event.mouse().y) &&
+                           CaptureMouse(event);
+        if (hover != *hover_) {
+          *hover_ = hover;
+          Invalidate(event);
+        }
       }
 
       return ComponentBase::OnEvent(event);
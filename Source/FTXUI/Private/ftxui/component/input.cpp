@@ -444,9 +444,13 @@ class InputBase : public ComponentBase, public InputOption {
   }
 
   bool HandleMouse(Event event) {
-    hovered_ = box_.Contain(event.mouse().x,  //
-                            event.mouse().y) &&
-               CaptureMouse(event);
+    const bool hovered = box_.Contain(event.mouse().x,  //
+                                      event.mouse().y) &&
+                         CaptureMouse(event);
+    if (hovered != hovered_) {
+      hovered_ = hovered;
+      Invalidate(event);
+    }
     if (!hovered_) {
       return false;
     }
@@ -317,7 +317,10 @@ class MenuBase : public ComponentBase, public MenuOption {
       }
 
       TakeFocus();
-      focused_entry() = i;
+      if (focused_entry() != i) {
+        focused_entry() = i;
+        Invalidate(event);
+      }
       if (event.mouse().button == Mouse::Left &&
           event.mouse().motion == Mouse::Released) {
         if (selected() != i) {
@@ -677,7 +680,11 @@ Component MenuEntry(MenuEntryOption option) {
         return false;
       }
 
-      hovered_ = box_.Contain(event.mouse().x, event.mouse().y);
+      const bool hovered = box_.Contain(event.mouse().x, event.mouse().y);
+      if (hovered != hovered_) {
+        hovered_ = hovered;
+        Invalidate(event);
+      }
 
       if (!hovered_) {
         return false;
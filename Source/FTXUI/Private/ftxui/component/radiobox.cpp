@@ -122,7 +122,10 @@ class RadioboxBase : public ComponentBase, public RadioboxOption {
       }
 
       TakeFocus();
-      focused_entry() = i;
+      if (focused_entry() != i) {
+        focused_entry() = i;
+        Invalidate(event);
+      }
       if (event.mouse().button == Mouse::Left &&
           event.mouse().motion == Mouse::Released) {
         if (selected() != i) {
@@ -0,0 +1,178 @@
+// Copyright 2023 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#if defined(__linux__)
+
+#include "ftxui/component/reactor.hpp"
+
+#include <pthread.h>       // for pthread_sigmask
+#include <sys/epoll.h>     // for epoll_event, epoll_ctl, epoll_wait, EPOLLIN
+#include <sys/eventfd.h>   // for eventfd, EFD_CLOEXEC, EFD_NONBLOCK
+#include <sys/signalfd.h>  // for signalfd, signalfd_siginfo, SFD_CLOEXEC
+#include <sys/timerfd.h>   // for timerfd_create, timerfd_settime
+#include <unistd.h>        // for read, write, close
+#include <array>           // for array
+#include <atomic>          // for atomic
+#include <cerrno>          // for errno, EAGAIN, EINTR, EWOULDBLOCK
+#include <csignal>         // for sigemptyset, sigaddset, SIGWINCH, SIGTSTP
+#include <cstdint>         // for uint64_t
+#include <tuple>           // for ignore
+#include <utility>         // for move
+
+#include "ftxui/component/task.hpp"  // for AnimationTask
+
+namespace ftxui {
+
+namespace {
+
+// The eventfd waking up the reactors. It is created by the first reactor and
+// never closed, so that a thread or a signal handler writing to it can't race
+// with a reactor being destroyed, and write to a reused fd number.
+std::atomic<int> g_wakeup_fd = -1;  // NOLINT
+// Whether a reactor is active. Otherwise, WakeupActive() does nothing.
+std::atomic<bool> g_active = false;  // NOLINT
+
+// Animation at around 60fps, like the animation thread.
+constexpr long kFrameNanoseconds = 15'000'000;  // NOLINT
+// The delay after which the pending input is flushed, like the input thread.
+constexpr int kInputTimeoutMilliseconds = 20;
+
+void EpollAdd(int epoll_fd, int fd) {
+  epoll_event event = {};
+  event.events = EPOLLIN;
+  event.data.fd = fd;
+  epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event);
+}
+
+int WakeupFd() {
+  int fd = g_wakeup_fd;
+  if (fd >= 0) {
+    return fd;
+  }
+  const int created = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (g_wakeup_fd.compare_exchange_strong(fd, created)) {
+    return created;
+  }
+  close(created);
+  return fd;
+}
+
+}  // namespace
+
+Reactor::Reactor(int input_fd,
+                 Sender<Task> input,
+                 Sender<Task> animation,
+                 void (*on_signal)(int))
+    : input_fd_(input_fd),
+      parser_(std::move(input)),
+      animation_(std::move(animation)),
+      on_signal_(on_signal) {
+  sigset_t mask;
+  sigemptyset(&mask);
+  sigaddset(&mask, SIGWINCH);
+  sigaddset(&mask, SIGTSTP);
+  pthread_sigmask(SIG_BLOCK, &mask, &previous_mask_);
+
+  epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+  event_fd_ = WakeupFd();
+  Read(event_fd_);  // Drop the wakeups sent to a previous reactor.
+  timer_fd_ = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+  signal_fd_ = signalfd(-1, &mask, SFD_NONBLOCK | SFD_CLOEXEC);
+  EpollAdd(epoll_fd_, input_fd_);
+  EpollAdd(epoll_fd_, event_fd_);
+  EpollAdd(epoll_fd_, timer_fd_);
+  EpollAdd(epoll_fd_, signal_fd_);
+  g_active = true;
+}
+
+Reactor::~Reactor() {
+  g_active = false;
+  for (const int fd : {signal_fd_, timer_fd_, epoll_fd_}) {
+    close(fd);
+  }
+  pthread_sigmask(SIG_SETMASK, &previous_mask_, nullptr);
+}
+
+bool Reactor::Block(int timeout) {
+  // Pending input is flushed after a delay.
+  int wait = timeout;
+  if (parser_.HasPending() &&
+      (wait < 0 || wait > kInputTimeoutMilliseconds)) {
+    wait = kInputTimeoutMilliseconds;
+  }
+  std::array<epoll_event, 4> events;  // NOLINT
+  const int count =
+      epoll_wait(epoll_fd_, events.data(), int(events.size()), wait);
+  if (count == 0) {
+    if (parser_.HasPending()) {
+      parser_.Timeout(wait);
+    }
+    return wait == timeout;
+  }
+
+  bool woken = false;
+  for (int i = 0; i < count; ++i) {
+    const int fd = events[size_t(i)].data.fd;  // NOLINT
+    if (fd == input_fd_) {
+      std::array<char, 100> buffer;  // NOLINT
+      ssize_t l = 0;
+      do {
+        l = read(input_fd_, buffer.data(), buffer.size());
+      } while (l < 0 && errno == EINTR);
+      if (l < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+        continue;
+      }
+      if (l <= 0) {
+        // The input was closed.
+        epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, input_fd_, nullptr);
+        continue;
+      }
+      for (ssize_t j = 0; j < l; ++j) {
+        parser_.Add(buffer[size_t(j)]);  // NOLINT
+      }
+    } else if (fd == timer_fd_) {
+      if (Read(timer_fd_)) {
+        timer_armed_ = false;
+        animation_->Send(AnimationTask());
+      }
+    } else if (fd == signal_fd_) {
+      signalfd_siginfo info;
+      while (read(signal_fd_, &info, sizeof(info)) == sizeof(info)) {
+        on_signal_(int(info.ssi_signo));
+        woken = true;
+      }
+    } else if (fd == event_fd_) {
+      woken |= Read(event_fd_);
+    }
+  }
+  return woken;
+}
+
+// static
+void Reactor::WakeupActive() {
+  const int fd = g_wakeup_fd;
+  if (fd >= 0 && g_active) {
+    const uint64_t one = 1;
+    std::ignore = write(fd, &one, sizeof(one));
+  }
+}
+
+void Reactor::RequestAnimationFrame() {
+  if (timer_armed_) {
+    return;
+  }
+  timer_armed_ = true;
+  itimerspec spec = {};
+  spec.it_value.tv_nsec = kFrameNanoseconds;
+  timerfd_settime(timer_fd_, 0, &spec, nullptr);
+}
+
+// Consume the counter of an eventfd or a timerfd.
+bool Reactor::Read(int fd) {
+  uint64_t value = 0;
+  return read(fd, &value, sizeof(value)) == sizeof(value);
+}
+
+}  // namespace ftxui
+
+#endif  // defined(__linux__)
@@ -0,0 +1,69 @@
+// Copyright 2023 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#ifndef FTXUI_COMPONENT_REACTOR_HPP
+#define FTXUI_COMPONENT_REACTOR_HPP
+
+#include "HAL/Platform.h"
+
+#if defined(__linux__)
+#include <signal.h>  // for sigset_t
+
+#include "ftxui/component/receiver.hpp"               // for Sender
+#include "ftxui/component/task.hpp"                   // for Task
+#include "ftxui/component/terminal_input_parser.hpp"  // for TerminalInputParser
+#endif
+
+namespace ftxui {
+
+#if defined(__linux__)
+
+// A single threaded replacement for the input and animation threads, built on
+// epoll. It waits on the terminal input, a signalfd, a timerfd armed on
+// animation requests, and an eventfd to be woken up. Linux only.
+class FTXUI_API Reactor {
+ public:
+  // |on_signal| receives the SIGWINCH and SIGTSTP signals. They are blocked on
+  // the calling thread for the lifetime of the reactor.
+  Reactor(int input_fd,
+          Sender<Task> input,
+          Sender<Task> animation,
+          void (*on_signal)(int));
+  ~Reactor();
+  Reactor(const Reactor&) = delete;
+  Reactor& operator=(const Reactor&) = delete;
+
+  // Wait for something to happen and process it, for at most |timeout|
+  // milliseconds when it isn't negative. Return true when woken up by a
+  // signal, by WakeupActive(), or once |timeout| elapsed.
+  bool Block(int timeout = -1);
+
+  // Make Block() return, for the active reactor. Can be called from any
+  // thread, and from signal handlers.
+  static void WakeupActive();
+
+  // Send an AnimationTask after one frame, unless one is already planned.
+  void RequestAnimationFrame();
+
+ private:
+  bool Read(int fd);
+
+  int input_fd_;
+  TerminalInputParser parser_;
+  Sender<Task> animation_;
+  void (*on_signal_)(int);
+
+  int epoll_fd_ = -1;
+  int event_fd_ = -1;
+  int timer_fd_ = -1;
+  int signal_fd_ = -1;
+  bool timer_armed_ = false;
+  sigset_t previous_mask_;
+};
+#else
+class Reactor {};  // Unsupported.
+#endif
+
+}  // namespace ftxui
+
+#endif  // FTXUI_COMPONENT_REACTOR_HPP
@@ -11,6 +11,9 @@
 #include <functional>        // for function
 #include <initializer_list>  // for initializer_list
 #include <iostream>  // for cout, ostream, operator<<, basic_ostream, endl, flush
+#include <memory>    // for make_unique, unique_ptr, make_shared
+#include <mutex>     // for mutex, lock_guard
+#include <optional>  // for optional
 #include <stack>     // for stack
 #include <thread>    // for thread, sleep_for
 #include <tuple>     // for _Swallow_assign, ignore
@@ -24,9 +27,12 @@
 #include "ftxui/component/component_base.hpp"  // for ComponentBase
 #include "ftxui/component/event.hpp"           // for Event
 #include "ftxui/component/loop.hpp"            // for Loop
+#include "ftxui/component/mouse.hpp"           // for Mouse
+#include "ftxui/component/reactor.hpp"         // for Reactor
 #include "ftxui/component/receiver.hpp"  // for ReceiverImpl, Sender, MakeReceiver, SenderImpl, Receiver
 #include "ftxui/component/screen_interactive.hpp"
 #include "ftxui/component/terminal_input_parser.hpp"  // for TerminalInputParser
+#include "ftxui/component/timer_wheel.hpp"            // for TimerWheel
 #include "ftxui/dom/node.hpp"                         // for Node, Render
 #include "ftxui/dom/requirement.hpp"                  // for Requirement
 #include "ftxui/screen/terminal.hpp"                  // for Dimensions, Size
@@ -75,6 +81,69 @@ void Flush() {
 constexpr int timeout_milliseconds = 20;
 [[maybe_unused]] constexpr int timeout_microseconds =
     timeout_milliseconds * 1000;
+
+// The lanes of the task queue, by decreasing priority.
+enum TaskLane : size_t {
+  kInputLane,
+  kResizeLane,
+  kClosureLane,
+  kAnimationLane,
+  kLaneCount,
+};
+
+// The time every lane can spend per frame. The remaining tasks are run on the
+// next frame, so that a burst of tasks can't delay the drawing.
+constexpr std::array<std::chrono::milliseconds, kLaneCount> kLaneBudget = {
+    std::chrono::milliseconds(16),  // Input.
+    std::chrono::milliseconds(16),  // Resize.
+    std::chrono::milliseconds(8),   // Closure.
+    std::chrono::milliseconds(4),   // Animation.
+};
+
+// Whether |next| supersedes |previous|, which can then be skipped. This is the
+// case of consecutive mouse motions with the same buttons and modifiers, and of
+// consecutive resizes. Repeated navigation keys are included with |keys|.
+bool IsNavigationKey(const Event& event) {
+  return event == Event::ArrowLeft || event == Event::ArrowRight ||
+         event == Event::ArrowUp || event == Event::ArrowDown ||
+         event == Event::ArrowLeftCtrl || event == Event::ArrowRightCtrl ||
+         event == Event::ArrowUpCtrl || event == Event::ArrowDownCtrl ||
+         event == Event::PageUp || event == Event::PageDown ||
+         event == Event::Home || event == Event::End;
+}
+
+bool Coalesces(const Task& previous, const Task& next, bool keys) {
+  const Event* a = std::get_if<Event>(&previous);
+  const Event* b = std::get_if<Event>(&next);
+  if (!a || !b || a->is_cursor_reporting() || b->is_cursor_reporting()) {
+    return false;
+  }
+
+  if (a->is_mouse() || b->is_mouse()) {
+    if (!a->is_mouse() || !b->is_mouse()) {
+      return false;
+    }
+    const Mouse& ma = a->mouse();
+    const Mouse& mb = b->mouse();
+    return ma.moved && mb.moved && ma.button == mb.button &&
+           ma.motion == mb.motion && ma.shift == mb.shift &&
+           ma.meta == mb.meta && ma.control == mb.control;
+  }
+
+  if (*a == Event::Custom) {
+    return *b == Event::Custom;
+  }
+  return keys && *a == *b && IsNavigationKey(*a);
+}
+
+size_t LaneOf(const Task& task) {
+  // Resizes are reported as Event::Custom.
+  if (const Event* event = std::get_if<Event>(&task)) {
+    return *event == Event::Custom ? kResizeLane : kInputLane;
+  }
+  return std::holds_alternative<ClosureTask>(task) ? kClosureLane
+                                                    : kAnimationLane;
+}
 #if defined(_WIN32)
 
 void EventListener(std::atomic<bool>* quit, Sender<Task> out) {
@@ -115,7 +184,7 @@ void EventListener(std::atomic<bool>* quit, Sender<Task> out) {
           }
         } break;
         case WINDOW_BUFFER_SIZE_EVENT:
-          out->Send(Event::Special({0}));
+          out->Send(Event::Special({0}), kResizeLane);
           break;
         case MENU_EVENT:
         case FOCUS_EVENT:
@@ -226,6 +295,10 @@ void RecordSignal(int signal) {
     default:
       break;
   }
+
+#if defined(__linux__)
+  Reactor::WakeupActive();
+#endif
 }
 
 void ExecuteSignalHandlers() {
@@ -272,6 +345,7 @@ enum class DECMode {
   kMouseUrxvtMode = 1015,
   kMouseSgrPixelsMode = 1016,
   kAlternateScreen = 1049,
+  kSynchronizedOutput = 2026,
 };
 
 // Device Status Report (DSR) {
@@ -302,6 +376,32 @@ std::string Reset(const std::vector<DECMode>& parameters) {
   return CSI + "?" + Serialize(parameters) + "l";
 }
 
+// DEC Request Mode (DECRQM). The terminal replies "CSI ? Pd ; Ps $ y".
+std::string RequestMode(DECMode mode) {
+  return CSI + "?" + std::to_string(int(mode)) + "$p";
+}
+
+// Whether |event| is the reply to RequestMode(mode), telling the mode is
+// supported.
+bool IsModeSupported(const Event& event, DECMode mode) {
+  const std::string prefix = CSI + "?" + std::to_string(int(mode)) + ";";
+  const std::string& input = event.input();
+  if (input.size() != prefix.size() + 3 ||
+      input.compare(0, prefix.size(), prefix) != 0 ||
+      input.compare(prefix.size() + 1, 2, "$y") != 0) {
+    return false;
+  }
+  // 1: set, 2: reset, 3: permanently set.
+  const char ps = input[prefix.size()];
+  return ps == '1' || ps == '2' || ps == '3';
+}
+
+bool IsModeReport(const Event& event) {
+  const std::string& input = event.input();
+  return input.size() > 4 && input.compare(0, 3, CSI + "?") == 0 &&
+         input.compare(input.size() - 2, 2, "$y") == 0;
+}
+
 // Device Status Report (DSR)
 std::string DeviceStatusReport(DSRMode ps) {
   return CSI + std::to_string(int(ps)) + "n";
@@ -330,6 +430,17 @@ void AnimationListener(std::atomic<bool>* quit, Sender<Task> out) {
   }
 }
 
+// The milliseconds until |deadline|, rounded up, or -1 without deadline.
+int MillisecondsUntil(
+    std::optional<std::chrono::steady_clock::time_point> deadline) {
+  if (!deadline) {
+    return -1;
+  }
+  const auto delay = std::chrono::ceil<std::chrono::milliseconds>(
+      *deadline - std::chrono::steady_clock::now());
+  return int(std::max<std::chrono::milliseconds::rep>(delay.count(), 0));
+}
+
 }  // namespace
 
 ScreenInteractive::ScreenInteractive(int dimx,
@@ -339,7 +450,21 @@ ScreenInteractive::ScreenInteractive(int dimx,
     : Screen(dimx, dimy),
       dimension_(dimension),
       use_alternative_screen_(use_alternative_screen) {
-  task_receiver_ = MakeReceiver<Task>();
+  task_receiver_ = MakeReceiver<Task>(kLaneCount);
+  timers_ = std::make_unique<TimerWheel>(std::chrono::steady_clock::now());
+}
+
+ScreenInteractive::~ScreenInteractive() {
+  // The workers post to this screen. They are stopped first.
+  worker_pool_.reset();
+  // The coroutines still waiting can't be resumed anymore.
+  timers_.reset();
+  for (auto handle : frame_waiters_) {
+    handle.destroy();
+  }
+  for (auto* waiter : event_waiters_) {
+    waiter->handle_.destroy();
+  }
 }
 
 // static
@@ -402,8 +527,213 @@ void ScreenInteractive::TrackMouse(bool enable) {
   track_mouse_ = enable;
 }
 
-/// @brief Add a task to the main loop. 
-/// It will be executed later, after every other scheduled tasks.
+/// @brief Set whether repeated navigation keys are coalesced. When the
+/// application can't keep up with the key auto-repeat, the consecutive
+/// identical keys waiting to be handled are then dispatched once. This applies
+/// to the arrows, with or without Ctrl, PageUp, PageDown, Home and End. The
+/// characters and the editing keys, like Backspace, are never coalesced.
+/// @param enable Whether to coalesce repeated navigation keys.
+/// @note Mouse motions and resizes are always coalesced.
+/// @note This must be called outside of the main loop. E.g. before calling
+/// `ScreenInteractive::Loop`.
+///
+/// ### Example
+///
+/// ```cpp
+/// auto screen = ScreenInteractive::Fullscreen();
+/// screen.CoalesceRepeatedKeys();
+/// screen.Loop(component);
+/// ```
+void ScreenInteractive::CoalesceRepeatedKeys(bool enable) {
+  coalesce_repeated_keys_ = enable;
+}
+
+/// @brief Set whether the terminal input, the signals, the animations and the
+/// posted tasks are all waited for on the main loop thread, using epoll. An
+/// idle application then doesn't wake up periodically, and input isn't
+/// delayed by polling.
+/// @param enable Whether to use the reactor.
+/// @note This is only supported on Linux. Elsewhere, it does nothing.
+/// @note This must be called outside of the main loop. E.g. before calling
+/// `ScreenInteractive::Loop`.
+void ScreenInteractive::UseReactor(bool enable) {
+  use_reactor_ = enable;
+}
+
+/// @brief Set the maximum number of frames drawn per second. The tasks
+/// received before the next frame are all handled before drawing it once. This
+/// bounds the work done during a storm of events.
+/// @param fps The maximum frame rate. Zero or less draws after every batch of
+/// tasks. The default is 60.
+void ScreenInteractive::SetFrameRate(int fps) {
+  frame_budget_ = std::chrono::steady_clock::duration::zero();
+  if (fps > 0) {
+    frame_budget_ = std::chrono::steady_clock::duration(std::chrono::seconds(1));
+    frame_budget_ /= fps;
+  }
+}
+
+/// @brief Set whether every event draws a new frame, even when no component
+/// handled it. By default, only the events handled by a component, and
+/// Event::Custom, invalidate the frame.
+/// @param enable Whether every event invalidates the frame.
+/// @note This is useful for components changing their state without returning
+/// true from `ComponentBase::OnEvent`.
+void ScreenInteractive::InvalidateOnEveryEvent(bool enable) {
+  invalidate_on_every_event_ = enable;
+}
+
+/// @brief Set the number of worker threads used by RunAsync.
+/// @param count The number of workers. Zero, the default, uses one per
+/// hardware thread.
+/// @note This must be called before the first call to `RunAsync`.
+void ScreenInteractive::SetWorkerCount(size_t count) {
+  worker_count_ = count;
+}
+
+/// @brief Return the pool of worker threads, running the functions given to
+/// RunAsync. Their continuations are posted to this screen, which is redrawn
+/// after each of them. The continuations posted while the loop isn't running
+/// wait for the next one. The workers are started on first use, and stopped
+/// when the screen is destroyed, once their pending functions are done.
+/// @note This must be called from the main loop thread, or from a worker.
+/// @ingroup component
+WorkerPool& ScreenInteractive::Workers() {
+  if (!worker_pool_) {
+    const size_t count = worker_count_ ? worker_count_
+                                       : std::thread::hardware_concurrency();
+    worker_pool_ = std::make_unique<WorkerPool>(
+        [this](ClosureTask task) { PostContinuation(std::move(task)); },
+        count);
+  }
+  return *worker_pool_;
+}
+
+/// @brief Run |fn| on the main loop after |delay|. The timers are kept in a
+/// timer wheel, so that setting and clearing them is O(1), even with thousands
+/// pending, and the loop only wakes up when one is due.
+/// @param fn The function to run. Call `Invalidate()` to draw its effects.
+/// @param delay The delay, rounded up to the millisecond.
+/// @return The id of the timer, for ClearTimer.
+/// @note This must be called from the main loop thread.
+/// @ingroup component
+uint64_t ScreenInteractive::SetTimeout(
+    ClosureTask fn,
+    std::chrono::steady_clock::duration delay) {
+  return timers_->Add(std::chrono::steady_clock::now() + delay, std::move(fn));
+}
+
+/// @brief Run |fn| on the main loop every |period|, until cleared.
+/// @param fn The function to run. Call `Invalidate()` to draw its effects.
+/// @param period The period, rounded up to the millisecond.
+/// @return The id of the timer, for ClearTimer.
+/// @note This must be called from the main loop thread.
+/// @ingroup component
+uint64_t ScreenInteractive::SetInterval(
+    ClosureTask fn,
+    std::chrono::steady_clock::duration period) {
+  return timers_->Add(std::chrono::steady_clock::now() + period, std::move(fn),
+                      period);
+}
+
+/// @brief Cancel a timer set by SetTimeout or SetInterval. Clearing a timer
+/// already run, or already cleared, does nothing.
+/// @param id The id of the timer.
+/// @note This must be called from the main loop thread.
+/// @ingroup component
+void ScreenInteractive::ClearTimer(uint64_t id) {
+  timers_->Remove(id);
+}
+
+/// @brief Return a function calling |fn| once it hasn't been called for
+/// |delay|. E.g. to filter a list once the user stopped typing.
+/// @param fn The function to debounce.
+/// @param delay The delay after the last call.
+/// @note The returned function must be called from the main loop thread.
+/// @ingroup component
+Closure ScreenInteractive::Debounce(
+    Closure fn,
+    std::chrono::steady_clock::duration delay) {
+  struct State {
+    Closure fn;
+    uint64_t timer = 0;
+  };
+  auto state = std::make_shared<State>();
+  state->fn = std::move(fn);
+  return [this, state, delay] {
+    ClearTimer(state->timer);
+    state->timer = SetTimeout([state] { state->fn(); }, delay);
+  };
+}
+
+/// @brief Return a function calling |fn| at most once per |period|. The first
+/// call runs immediately, and the calls made during the period are merged
+/// into one at its end.
+/// @param fn The function to throttle.
+/// @param period The minimal time between two runs of |fn|.
+/// @note The returned function must be called from the main loop thread.
+/// @ingroup component
+Closure ScreenInteractive::Throttle(
+    Closure fn,
+    std::chrono::steady_clock::duration period) {
+  struct State {
+    Closure fn;
+    std::chrono::steady_clock::time_point next_run;
+    bool trailing = false;
+  };
+  auto state = std::make_shared<State>();
+  state->fn = std::move(fn);
+  return [this, state, period] {
+    if (state->trailing) {
+      return;
+    }
+    const auto now = std::chrono::steady_clock::now();
+    if (now >= state->next_run) {
+      state->next_run = now + period;
+      state->fn();
+      return;
+    }
+    state->trailing = true;
+    SetTimeout(
+        [state, period] {
+          state->trailing = false;
+          state->next_run = std::chrono::steady_clock::now() + period;
+          state->fn();
+        },
+        state->next_run - now);
+  };
+}
+
+/// @brief Return an awaitable drawing a new frame, and resuming the coroutine
+/// once it is drawn.
+/// @ingroup component
+NextFrameAwaiter ScreenInteractive::NextFrame() {
+  return NextFrameAwaiter(this);
+}
+
+/// @brief Return an awaitable resuming the coroutine on the main loop after
+/// |duration|.
+/// @param duration The delay.
+/// @ingroup component
+SleepAwaiter ScreenInteractive::Sleep(
+    std::chrono::steady_clock::duration duration) {
+  return {this, duration};
+}
+
+/// @brief Return an awaitable resuming the coroutine with the next event
+/// accepted by |filter|. The event is handled by the components as well.
+/// @param filter The events to wait for. Every event when empty.
+/// @ingroup component
+NextEventAwaiter ScreenInteractive::NextEvent(
+    std::function<bool(const Event&)> filter) {
+  return {this, std::move(filter)};
+}
+
+/// @brief Add a task to the main loop.
+/// It will be executed later, after every other scheduled tasks of the same
+/// kind. Events are executed first, then the closures, then the animations.
+/// The closures are moved, and the ones capturing up to
+/// `ClosureTask::kInlineSize` bytes are posted without allocating.
 /// @ingroup component
 void ScreenInteractive::Post(Task task) {
   // Task/Events sent toward inactive screen or screen waiting to become
@@ -412,14 +742,51 @@ void ScreenInteractive::Post(Task task) {
     return;
   }
 
-  task_sender_->Send(std::move(task));
+  const size_t lane = LaneOf(task);
+  task_sender_->Send(std::move(task), lane);
+}
+
+// private
+// Post a continuation from a worker. Unlike Post(), it is kept until the loop
+// runs again, instead of being dropped.
+void ScreenInteractive::PostContinuation(ClosureTask task) {
+  ClosureTask continuation = [this, task = std::move(task)]() mutable {
+    task();
+    Invalidate();
+  };
+  const std::lock_guard<std::mutex> lock(continuations_mutex_);
+  if (task_sender_) {
+    task_sender_->Send(std::move(continuation), kClosureLane);
+  } else {
+    pending_continuations_.push_back(std::move(continuation));
+  }
+}
+
+// private
+// Open the lane of the closures, and send the continuations posted meanwhile.
+void ScreenInteractive::OpenClosureLane() {
+  const std::lock_guard<std::mutex> lock(continuations_mutex_);
+  task_sender_ = task_receiver_->MakeSender(kClosureLane);
+  for (ClosureTask& continuation : pending_continuations_) {
+    task_sender_->Send(std::move(continuation), kClosureLane);
+  }
+  pending_continuations_.clear();
 }
 
 /// @brief Add an event to the main loop.
 /// It will be executed later, after every other scheduled events.
 /// @ingroup component
 void ScreenInteractive::PostEvent(Event event) {
-  Post(event);
+  Post(std::move(event));
+}
+
+/// @brief Draw a new frame after the current task. Use it from the posted
+/// closures changing the state of the components.
+/// @note This must be called from the main loop thread. Elsewhere, use
+/// `PostEvent(Event::Custom)`.
+/// @ingroup component
+void ScreenInteractive::Invalidate() {
+  frame_valid_ = false;
 }
 
 /// @brief Add a task to draw the screen one more time, until all the animations
@@ -429,6 +796,11 @@ void ScreenInteractive::RequestAnimationFrame() {
     return;
   }
   animation_requested_ = true;
+#if defined(__linux__)
+  if (reactor_) {
+    reactor_->RequestAnimationFrame();
+  }
+#endif
   auto now = animation::Clock::now();
   const auto time_histeresis = std::chrono::milliseconds(33);
   if (now - previous_animation_time_ >= time_histeresis) {
@@ -631,23 +1003,42 @@ void ScreenInteractive::Install() {
     enable({DECMode::kMouseSgrExtMode});
   }
 
+  // Frames are wrapped into synchronized updates once the terminal replies it
+  // supports them.
+  std::cout << RequestMode(DECMode::kSynchronizedOutput);
+
   // After installing the new configuration, flush it to the terminal to
   // ensure it is fully applied:
   Flush();
 
   quit_ = false;
-  task_sender_ = task_receiver_->MakeSender();
-  event_listener_ =
-      std::thread(&EventListener, &quit_, task_receiver_->MakeSender());
-  animation_listener_ =
-      std::thread(&AnimationListener, &quit_, task_receiver_->MakeSender());
+#if defined(__linux__)
+  if (use_reactor_) {
+    reactor_ = std::make_unique<Reactor>(
+        STDIN_FILENO, task_receiver_->MakeSender(kInputLane),
+        task_receiver_->MakeSender(kAnimationLane), &RecordSignal);
+    task_receiver_->SetNotifier(&Reactor::WakeupActive);
+    OpenClosureLane();
+    if (animation_requested_) {
+      reactor_->RequestAnimationFrame();
+    }
+    return;
+  }
+#endif
+  OpenClosureLane();
+  event_listener_ = std::thread(&EventListener, &quit_,
+                                task_receiver_->MakeSender(kInputLane));
+  animation_listener_ = std::thread(
+      &AnimationListener, &quit_, task_receiver_->MakeSender(kAnimationLane));
 }
 
 // private
 void ScreenInteractive::Uninstall() {
   ExitNow();
-  event_listener_.join();
-  animation_listener_.join();
+  if (event_listener_.joinable()) {
+    event_listener_.join();
+    animation_listener_.join();
+  }
   OnExit();
 }
 
@@ -655,19 +1046,65 @@ void ScreenInteractive::Uninstall() {
 // NOLINTNEXTLINE
 void ScreenInteractive::RunOnceBlocking(Component component) {
   ExecuteSignalHandlers();
-  Task task;
-  if (task_receiver_->Receive(&task)) {
-    HandleTask(component, task);
+  // An invalid frame is drawn at its deadline, together with the tasks
+  // received meanwhile.
+  // The timers are run at their deadline, or with the next animation tick
+  // without reactor.
+  if (!frame_valid_) {
+    const auto timer = timers_->NextDeadline();
+    std::this_thread::sleep_until(timer ? std::min(*timer, next_frame_)
+                                        : next_frame_);
+  } else {
+#if defined(__linux__)
+    if (reactor_) {
+      task_receiver_->Wait([this] {
+        return reactor_->Block(MillisecondsUntil(timers_->NextDeadline()));
+      });
+      ExecuteSignalHandlers();
+    } else {
+      task_receiver_->Wait();
+    }
+#else
+    task_receiver_->Wait();
+#endif
   }
   RunOnce(component);
 }
 
 // private
 void ScreenInteractive::RunOnce(Component component) {
+  // Run the pending tasks by priority, within the budget of their lane. After
+  // every task, the higher priority lanes are checked again, so that input
+  // isn't delayed by background work.
+  std::array<std::chrono::steady_clock::duration, kLaneCount> spent = {};
   Task task;
-  while (task_receiver_->ReceiveNonBlocking(&task)) {
+  size_t lane = 0;
+  while (lane < kLaneCount) {
+    if (spent[lane] >= kLaneBudget[lane] ||
+        !task_receiver_->ReceiveNonBlocking(&task, lane)) {
+      ++lane;
+      continue;
+    }
+    // Only the last of consecutive equivalent events is handled.
+    while (const Task* next = task_receiver_->Peek(lane)) {
+      if (!Coalesces(task, *next, coalesce_repeated_keys_)) {
+        break;
+      }
+      task_receiver_->ReceiveNonBlocking(&task, lane);
+    }
+
+    const auto start = std::chrono::steady_clock::now();
     HandleTask(component, task);
     ExecuteSignalHandlers();
+    spent[lane] += std::chrono::steady_clock::now() - start;
+    lane = 0;
+  }
+
+  timers_->Advance(std::chrono::steady_clock::now());
+
+  // Invalidations are coalesced until the next frame deadline.
+  if (!quit_ && std::chrono::steady_clock::now() < next_frame_) {
+    return;
   }
   Draw(std::move(component));
 }
@@ -686,19 +1123,29 @@ void ScreenInteractive::HandleTask(Component component, Task& task) {
         return;
       }
 
+      if (IsModeReport(arg)) {
+        if (IsModeSupported(arg, DECMode::kSynchronizedOutput)) {
+          synchronized_output_ = true;
+        }
+        return;
+      }
+
       if (arg.is_mouse()) {
         arg.mouse().x -= cursor_x_;
         arg.mouse().y -= cursor_y_;
       }
 
       arg.screen_ = this;
-      component->OnEvent(arg);
-      frame_valid_ = false;
+      const bool handled = component->OnEvent(arg);
+      if (handled || arg == Event::Custom || invalidate_on_every_event_) {
+        frame_valid_ = false;
+      }
+      ResumeEventWaiters(arg);
       return;
     }
 
     // Handle callback
-    if constexpr (std::is_same_v<T, Closure>) {
+    if constexpr (std::is_same_v<T, ClosureTask>) {
       arg();
       return;
     }
@@ -724,12 +1171,37 @@ void ScreenInteractive::HandleTask(Component component, Task& task) {
   // clang-format on
 }
 
+// private
+void ScreenInteractive::ResumeEventWaiters(const Event& event) {
+  if (event_waiters_.empty()) {
+    return;
+  }
+  // The resumed coroutines may wait again.
+  std::vector<NextEventAwaiter*> waiters;
+  std::swap(waiters, event_waiters_);
+  for (auto* waiter : waiters) {
+    if (waiter->filter_ && !waiter->filter_(event)) {
+      event_waiters_.push_back(waiter);
+      continue;
+    }
+    waiter->event_ = event;
+    waiter->handle_.resume();
+    frame_valid_ = false;
+  }
+}
+
 // private
 // NOLINTNEXTLINE
 void ScreenInteractive::Draw(Component component) {
   if (frame_valid_) {
     return;
   }
+  // Invalidations and coroutines waiting from the rendering are for the next
+  // frame.
+  frame_valid_ = true;
+  std::vector<std::coroutine_handle<>> waiters;
+  std::swap(waiters, frame_waiters_);
+
   auto document = component->Render();
   int dimx = 0;
   int dimy = 0;
@@ -755,6 +1227,9 @@ void ScreenInteractive::Draw(Component component) {
   }
 
   const bool resized = (dimx != dimx_) || (dimy != dimy_);
+  if (synchronized_output_) {
+    std::cout << Set({DECMode::kSynchronizedOutput});
+  }
   ResetCursorPosition();
   std::cout << ResetPosition(/*clear=*/resized);
 
@@ -762,7 +1237,7 @@ void ScreenInteractive::Draw(Component component) {
   if (resized) {
     dimx_ = dimx;
     dimy_ = dimy;
-    pixels_ = std::vector<std::vector<Pixel>>(dimy, std::vector<Pixel>(dimx));
+    pixels_ = std::vector<Pixel>(size_t(dimx) * size_t(dimy));
     cursor_.x = dimx_ - 1;
     cursor_.y = dimy_ - 1;
   }
@@ -814,9 +1289,19 @@ void ScreenInteractive::Draw(Component component) {
   }
 
   std::cout << ToString() << set_cursor_position;
+  if (synchronized_output_) {
+    std::cout << Reset({DECMode::kSynchronizedOutput});
+  }
   Flush();
   Clear();
-  frame_valid_ = true;
+  next_frame_ = std::chrono::steady_clock::now() + frame_budget_;
+
+  // The resumed coroutines may change the state. It is drawn in the next
+  // frame.
+  for (auto handle : waiters) {
+    handle.resume();
+    frame_valid_ = false;
+  }
 }
 
 // private
@@ -840,7 +1325,14 @@ void ScreenInteractive::Exit() {
 // private:
 void ScreenInteractive::ExitNow() {
   quit_ = true;
-  task_sender_.reset();
+  {
+    // The workers keep posting their continuations meanwhile.
+    const std::lock_guard<std::mutex> lock(continuations_mutex_);
+    task_sender_.reset();
+  }
+#if defined(__linux__)
+  reactor_.reset();
+#endif
 }
 
 // private:
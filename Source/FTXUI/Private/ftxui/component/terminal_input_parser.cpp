@@ -391,14 +391,13 @@ TerminalInputParser::Output TerminalInputParser::ParseMouse(  // NOLINT
     return SPECIAL;
   }
 
-  (void)altered;
-
   Output output(MOUSE);
   output.mouse.button = Mouse::Button((arguments[0] & 3) +          // NOLINT
                                       ((arguments[0] & 64) >> 4));  // NOLINT
   output.mouse.motion = Mouse::Motion(pressed);                     // NOLINT
   output.mouse.shift = bool(arguments[0] & 4);                      // NOLINT
   output.mouse.meta = bool(arguments[0] & 8);                       // NOLINT
+  output.mouse.moved = altered && bool(arguments[0] & 32);          // NOLINT
   output.mouse.x = arguments[1];                                    // NOLINT
   output.mouse.y = arguments[2];                                    // NOLINT
   return output;
@@ -25,6 +25,9 @@ class FTXUI_API TerminalInputParser {
   void Timeout(int time);
   void Add(char c);
 
+  // Whether the last characters are waiting for a timeout or more input.
+  bool HasPending() const { return !pending_.empty(); }
+
  private:
   unsigned char Current();
   bool Eat();
@@ -0,0 +1,245 @@
+// Copyright 2023 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include "ftxui/component/timer_wheel.hpp"
+
+#include <algorithm>  // for max, min
+#include <bit>        // for countr_zero, rotr
+#include <utility>    // for move, pair
+
+namespace ftxui {
+
+namespace {
+constexpr std::chrono::milliseconds kTick(1);
+}  // namespace
+
+TimerWheel::TimerWheel(Clock::time_point now) : origin_(now) {
+  for (auto& level : slots_) {
+    level.fill(kNone);
+  }
+}
+
+uint64_t TimerWheel::Add(Clock::time_point deadline,
+                         ClosureTask callback,
+                         Clock::duration period) {
+  uint32_t index = 0;
+  if (free_.empty()) {
+    index = uint32_t(timers_.size());
+    timers_.emplace_back();
+  } else {
+    index = free_.back();
+    free_.pop_back();
+  }
+  Timer& timer = timers_[index];
+  // Timers can't be due before the next tick, nor before their deadline.
+  timer.deadline = std::max(TickAfter(deadline), current_ + 1);
+  timer.period = 0;
+  if (period > Clock::duration::zero()) {
+    timer.period = uint64_t(std::chrono::ceil<std::chrono::milliseconds>(period) / kTick);
+  }
+  timer.callback = std::move(callback);
+  Place(index);
+  ++size_;
+  return (uint64_t(timer.generation) << 32) | index;
+}
+
+bool TimerWheel::Remove(uint64_t id) {
+  const auto index = uint32_t(id);
+  if (index >= timers_.size()) {
+    return false;
+  }
+  Timer& timer = timers_[index];
+  if (timer.generation != uint32_t(id >> 32) || timer.level == kFree) {
+    return false;
+  }
+  // A due timer is already unlinked, but it hasn't run yet. Bumping its
+  // generation cancels it.
+  if (timer.level != kDue) {
+    Unlink(index);
+  }
+  timer.level = kFree;
+  timer.callback = ClosureTask();
+  ++timer.generation;
+  free_.push_back(index);
+  --size_;
+  return true;
+}
+
+void TimerWheel::Advance(Clock::time_point now) {
+  const uint64_t target = TickOf(now);
+  while (current_ < target) {
+    // Jump over the ticks of the empty levels, up to the next cascade.
+    uint64_t granularity = 1;
+    for (int level = 0; level < kLevels && occupied_[size_t(level)] == 0;
+         ++level) {
+      granularity <<= kSlotBits;
+    }
+    if (granularity > 1) {
+      const uint64_t next = (current_ / granularity + 1) * granularity;
+      if (next > target) {
+        current_ = target;
+        return;
+      }
+      current_ = next - 1;
+    }
+
+    ++current_;
+    // Move the timers of the higher levels down, starting from the highest.
+    for (int level = kLevels - 1; level >= 1; --level) {
+      if ((current_ & ((uint64_t(1) << (kSlotBits * level)) - 1)) == 0) {
+        Cascade(level);
+      }
+    }
+    Fire(target);
+  }
+}
+
+std::optional<TimerWheel::Clock::time_point> TimerWheel::NextDeadline() const {
+  std::optional<uint64_t> next;
+  for (int level = 0; level < kLevels; ++level) {
+    const uint64_t occupied = occupied_[size_t(level)];
+    if (occupied == 0) {
+      continue;
+    }
+    // The first non empty slot after the current one, in the wheel order.
+    const int shift = kSlotBits * level;
+    const uint64_t block = current_ >> shift;
+    const int first = int((block + 1) & (kSlots - 1));
+    const uint64_t distance =
+        uint64_t(std::countr_zero(std::rotr(occupied, first))) + 1;
+    const uint64_t tick = (block + distance) << shift;
+    next = next ? std::min(*next, tick) : tick;
+  }
+  if (!next) {
+    return std::nullopt;
+  }
+  return TimeOf(*next);
+}
+
+uint64_t TimerWheel::TickOf(Clock::time_point time) const {
+  if (time <= origin_) {
+    return 0;
+  }
+  return uint64_t((time - origin_) / kTick);
+}
+
+// The first tick at or after |time|.
+uint64_t TimerWheel::TickAfter(Clock::time_point time) const {
+  if (time <= origin_) {
+    return 0;
+  }
+  return uint64_t(std::chrono::ceil<std::chrono::milliseconds>(time - origin_) /
+                  kTick);
+}
+
+TimerWheel::Clock::time_point TimerWheel::TimeOf(uint64_t tick) const {
+  return origin_ + tick * kTick;
+}
+
+// File the timer in the level of its distance to the current tick.
+void TimerWheel::Place(uint32_t index) {
+  Timer& timer = timers_[index];
+  const uint64_t delta = timer.deadline - current_;
+  int level = 0;
+  while (level < kLevels - 1 &&
+         delta >= (uint64_t(1) << (kSlotBits * (level + 1)))) {
+    ++level;
+  }
+  // The timers beyond the last level are filed in its farthest slot, and
+  // filed again once it is reached.
+  const uint64_t range = uint64_t(1) << (kSlotBits * kLevels);
+  const uint64_t deadline =
+      delta < range ? timer.deadline : current_ + range - 1;
+  const uint64_t slot = (deadline >> (kSlotBits * level)) & (kSlots - 1);
+
+  uint32_t& head = slots_[size_t(level)][slot];
+  timer.level = level;
+  timer.slot = slot;
+  timer.previous = kNone;
+  timer.next = head;
+  if (head != kNone) {
+    timers_[head].previous = index;
+  }
+  head = index;
+  occupied_[size_t(level)] |= uint64_t(1) << slot;
+}
+
+void TimerWheel::Unlink(uint32_t index) {
+  Timer& timer = timers_[index];
+  uint32_t& head = slots_[size_t(timer.level)][timer.slot];
+  if (timer.previous != kNone) {
+    timers_[timer.previous].next = timer.next;
+  } else {
+    head = timer.next;
+  }
+  if (timer.next != kNone) {
+    timers_[timer.next].previous = timer.previous;
+  }
+  if (head == kNone) {
+    occupied_[size_t(timer.level)] &= ~(uint64_t(1) << timer.slot);
+  }
+  timer.level = kFree;
+}
+
+void TimerWheel::Cascade(int level) {
+  const uint64_t slot = (current_ >> (kSlotBits * level)) & (kSlots - 1);
+  uint32_t index = slots_[size_t(level)][slot];
+  slots_[size_t(level)][slot] = kNone;
+  occupied_[size_t(level)] &= ~(uint64_t(1) << slot);
+  while (index != kNone) {
+    const uint32_t next = timers_[index].next;
+    Place(index);
+    index = next;
+  }
+}
+
+// Run the timers of the current tick. |target| is the tick Advance() moves
+// to.
+void TimerWheel::Fire(uint64_t target) {
+  const uint64_t slot = current_ & (kSlots - 1);
+  // Reuse the memory of the previous ticks.
+  std::vector<std::pair<uint32_t, uint32_t>> due = std::move(due_);
+  due.clear();
+  for (uint32_t index = slots_[0][slot]; index != kNone;
+       index = timers_[index].next) {
+    due.emplace_back(index, timers_[index].generation);
+  }
+  for (const auto& [index, generation] : due) {
+    Unlink(index);
+    timers_[index].level = kDue;
+  }
+
+  for (const auto& [index, generation] : due) {
+    // An earlier callback may have removed it.
+    Timer& timer = timers_[index];
+    if (timer.generation != generation) {
+      continue;
+    }
+    ClosureTask callback = std::move(timer.callback);
+    if (timer.period) {
+      // The periods missed while the loop was stalled are skipped, instead of
+      // being run in a burst. The timer keeps its phase.
+      timer.deadline += timer.period;
+      if (timer.deadline <= target) {
+        timer.deadline +=
+            (target - timer.deadline) / timer.period * timer.period +
+            timer.period;
+      }
+      Place(index);
+    } else {
+      timer.level = kFree;
+      ++timer.generation;
+      free_.push_back(index);
+      --size_;
+    }
+    callback();
+    // The callbacks can add timers, which moves |timers_|.
+    Timer& after = timers_[index];
+    if (after.generation == generation && after.level >= 0) {
+      after.callback = std::move(callback);
+    }
+  }
+  due_ = std::move(due);
+}
+
+}  // namespace ftxui
@@ -0,0 +1,89 @@
+// Copyright 2023 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#ifndef FTXUI_COMPONENT_TIMER_WHEEL_HPP
+#define FTXUI_COMPONENT_TIMER_WHEEL_HPP
+
+#include "HAL/Platform.h"
+
+#include <array>     // for array
+#include <chrono>    // for steady_clock, milliseconds
+#include <cstddef>   // for size_t
+#include <cstdint>   // for uint64_t, uint32_t
+#include <optional>  // for optional
+#include <utility>   // for pair
+#include <vector>    // for vector
+
+#include "ftxui/component/task.hpp"  // for ClosureTask
+
+namespace ftxui {
+
+// A hierarchical timer wheel, counting in ticks of one millisecond. Every level
+// has 64 slots, and a slot of the level n spans 64^n ticks. A timer is filed in
+// the level matching its distance to the current tick, and moves down the
+// levels as the time advances. Adding and removing a timer are O(1), and so is
+// every tick. The ticks without timers are skipped.
+class FTXUI_API TimerWheel {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  explicit TimerWheel(Clock::time_point now);
+
+  // Run |callback| at |deadline|, then every |period| when it is positive.
+  // Return an id for Remove(), never zero.
+  uint64_t Add(Clock::time_point deadline,
+               ClosureTask callback,
+               Clock::duration period = Clock::duration::zero());
+
+  // Return whether the timer was pending.
+  bool Remove(uint64_t id);
+
+  // Run the timers due at |now|. They can add and remove timers.
+  void Advance(Clock::time_point now);
+
+  // The time of the next step of the wheel, when a timer may be due, or
+  // nothing without timers.
+  std::optional<Clock::time_point> NextDeadline() const;
+
+  size_t size() const { return size_; }
+
+ private:
+  static constexpr int kLevels = 4;
+  static constexpr int kSlotBits = 6;
+  static constexpr uint64_t kSlots = 1 << kSlotBits;
+  static constexpr uint32_t kNone = ~uint32_t(0);
+  static constexpr int kFree = -1;  // The level of a timer not filed.
+  static constexpr int kDue = -2;   // The level of a timer about to run.
+
+  struct Timer {
+    uint64_t deadline = 0;  // In ticks.
+    uint64_t period = 0;    // In ticks.
+    ClosureTask callback;
+    uint32_t generation = 1;
+    uint32_t previous = kNone;
+    uint32_t next = kNone;
+    int level = kFree;
+    uint64_t slot = 0;
+  };
+
+  uint64_t TickOf(Clock::time_point time) const;
+  uint64_t TickAfter(Clock::time_point time) const;
+  Clock::time_point TimeOf(uint64_t tick) const;
+  void Place(uint32_t index);
+  void Unlink(uint32_t index);
+  void Cascade(int level);
+  void Fire(uint64_t target);
+
+  Clock::time_point origin_;
+  uint64_t current_ = 0;  // The last processed tick.
+  std::vector<Timer> timers_;
+  std::vector<uint32_t> free_;
+  std::array<std::array<uint32_t, kSlots>, kLevels> slots_;
+  std::array<uint64_t, kLevels> occupied_ = {};  // A bit per non empty slot.
+  size_t size_ = 0;
+  std::vector<std::pair<uint32_t, uint32_t>> due_;  // Index and generation.
+};
+
+}  // namespace ftxui
+
+#endif  // FTXUI_COMPONENT_TIMER_WHEEL_HPP
@@ -3,6 +3,7 @@
 // the LICENSE file.
 #define NOMINMAX
 #include <algorithm>
+#include <tuple>  // for make_tuple
 #include <ftxui/component/component.hpp>
 #include <ftxui/component/component_base.hpp>
 #include <ftxui/component/screen_interactive.hpp>  // for ScreenInteractive
@@ -155,6 +156,10 @@ class WindowImpl : public ComponentBase, public WindowOptions {
       return false;
     }
 
+    const auto hover_state = std::make_tuple(
+        mouse_hover_, resize_down_hover_, resize_top_hover_, resize_left_hover_,
+        resize_right_hover_);
+
     mouse_hover_ = box_window_.Contain(event.mouse().x, event.mouse().y);
 
     resize_down_hover_ = false;
@@ -176,6 +181,12 @@ class WindowImpl : public ComponentBase, public WindowOptions {
       resize_right_hover_ &= resize_right();
     }
 
+    if (hover_state != std::make_tuple(mouse_hover_, resize_down_hover_,
+                                       resize_top_hover_, resize_left_hover_,
+                                       resize_right_hover_)) {
+      Invalidate(event);
+    }
+
     if (captured_mouse_) {
       if (event.mouse().motion == Mouse::Released) {
         captured_mouse_ = nullptr;
@@ -0,0 +1,99 @@
+// Copyright 2023 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include "ftxui/component/worker_pool.hpp"
+
+#include <algorithm>  // for max
+#include <memory>     // for make_shared, make_unique
+#include <utility>    // for move
+
+namespace ftxui {
+
+namespace {
+// The pool and the index of the current worker thread, if any. The tasks
+// submitted from a worker go to its own queue.
+thread_local WorkerPool* t_worker_pool = nullptr;  // NOLINT
+thread_local size_t t_worker_index = 0;            // NOLINT
+}  // namespace
+
+WorkerPool::WorkerPool(std::function<void(ClosureTask)> post, size_t workers)
+    : post_(std::make_shared<const std::function<void(ClosureTask)>>(
+          std::move(post))) {
+  workers = std::max<size_t>(workers, 1);
+  for (size_t i = 0; i < workers; ++i) {
+    queues_.push_back(std::make_unique<Queue>());
+  }
+  for (size_t i = 0; i < workers; ++i) {
+    threads_.emplace_back(&WorkerPool::Work, this, i);
+  }
+}
+
+WorkerPool::~WorkerPool() {
+  {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    quit_ = true;
+  }
+  wakeup_.notify_all();
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+}
+
+void WorkerPool::Submit(ClosureTask task) {
+  const size_t index = t_worker_pool == this
+                           ? t_worker_index
+                           : next_queue_.fetch_add(1) % queues_.size();
+  {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    pending_.fetch_add(1);
+  }
+  {
+    Queue& queue = *queues_[index];
+    const std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks.push_back(std::move(task));
+  }
+  wakeup_.notify_one();
+}
+
+// Pop from the front of the worker's own queue, or steal from the back of
+// another one.
+bool WorkerPool::Pop(size_t worker, ClosureTask* task) {
+  for (size_t i = 0; i < queues_.size(); ++i) {
+    const bool own = (i == 0);
+    Queue& queue = *queues_[(worker + i) % queues_.size()];
+    const std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) {
+      continue;
+    }
+    if (own) {
+      *task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+    } else {
+      *task = std::move(queue.tasks.back());
+      queue.tasks.pop_back();
+    }
+    pending_.fetch_sub(1);
+    return true;
+  }
+  return false;
+}
+
+void WorkerPool::Work(size_t worker) {
+  t_worker_pool = this;
+  t_worker_index = worker;
+  ClosureTask task;
+  while (true) {
+    if (Pop(worker, &task)) {
+      task();
+      task = ClosureTask();
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    wakeup_.wait(lock, [&] { return quit_ || pending_.load() != 0; });
+    if (quit_) {
+      return;
+    }
+  }
+}
+
+}  // namespace ftxui
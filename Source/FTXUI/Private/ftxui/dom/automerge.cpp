@@ -20,11 +20,7 @@ Element automerge(Element child) {
     using NodeDecorator::NodeDecorator;
 
     void Render(Screen& screen) override {
-      for (int y = box_.y_min; y <= box_.y_max; ++y) {
-        for (int x = box_.x_min; x <= box_.x_max; ++x) {
-          screen.PixelAt(x, y).automerge = true;
-        }
-      }
+      screen.FillStyle(box_, Pixel::Automerge, Pixel::Automerge);
       Node::Render(screen);
     }
   };
@@ -90,22 +90,22 @@ class Border : public Node {
     screen.at(box_.x_min, box_.y_max) = charset_[2];  // NOLINT
     screen.at(box_.x_max, box_.y_max) = charset_[3];  // NOLINT
 
-    for (int x = box_.x_min + 1; x < box_.x_max; ++x) {
-      Pixel& p1 = screen.PixelAt(x, box_.y_min);
-      Pixel& p2 = screen.PixelAt(x, box_.y_max);
-      p1.character = charset_[4];  // NOLINT
-      p2.character = charset_[4];  // NOLINT
-      p1.automerge = true;
-      p2.automerge = true;
-    }
-    for (int y = box_.y_min + 1; y < box_.y_max; ++y) {
-      Pixel& p3 = screen.PixelAt(box_.x_min, y);
-      Pixel& p4 = screen.PixelAt(box_.x_max, y);
-      p3.character = charset_[5];  // NOLINT
-      p4.character = charset_[5];  // NOLINT
-      p3.automerge = true;
-      p4.automerge = true;
-    }
+    const auto draw = [&](const Box& line, const std::string& character) {
+      screen.ForEachRow(line, [&](Pixel* begin, Pixel* end) {
+        for (Pixel* pixel = begin; pixel != end; ++pixel) {
+          pixel->character = character;
+          pixel->automerge = true;
+        }
+      });
+    };
+    const int x_min = box_.x_min + 1;
+    const int x_max = box_.x_max - 1;
+    const int y_min = box_.y_min + 1;
+    const int y_max = box_.y_max - 1;
+    draw({x_min, x_max, box_.y_min, box_.y_min}, charset_[4]);  // NOLINT
+    draw({x_min, x_max, box_.y_max, box_.y_max}, charset_[4]);  // NOLINT
+    draw({box_.x_min, box_.x_min, y_min, y_max}, charset_[5]);  // NOLINT
+    draw({box_.x_max, box_.x_max, y_min, y_max}, charset_[5]);  // NOLINT
 
     // Draw title.
     if (children_.size() == 2) {
@@ -114,14 +114,13 @@ class Border : public Node {
 
     // Draw the border color.
     if (foreground_color_) {
-      for (int x = box_.x_min; x <= box_.x_max; ++x) {
-        screen.PixelAt(x, box_.y_min).foreground_color = *foreground_color_;
-        screen.PixelAt(x, box_.y_max).foreground_color = *foreground_color_;
-      }
-      for (int y = box_.y_min; y <= box_.y_max; ++y) {
-        screen.PixelAt(box_.x_min, y).foreground_color = *foreground_color_;
-        screen.PixelAt(box_.x_max, y).foreground_color = *foreground_color_;
-      }
+      const Color color = *foreground_color_;
+      const Box& b = box_;
+      const bool background = false;
+      screen.FillColor({b.x_min, b.x_max, b.y_min, b.y_min}, color, background);
+      screen.FillColor({b.x_min, b.x_max, b.y_max, b.y_max}, color, background);
+      screen.FillColor({b.x_min, b.x_min, b.y_min, b.y_max}, color, background);
+      screen.FillColor({b.x_max, b.x_max, b.y_min, b.y_max}, color, background);
     }
   }
 };
@@ -176,19 +175,11 @@ class BorderPixel : public Node {
       return;
     }
 
-    screen.PixelAt(box_.x_min, box_.y_min) = pixel_;
-    screen.PixelAt(box_.x_max, box_.y_min) = pixel_;
-    screen.PixelAt(box_.x_min, box_.y_max) = pixel_;
-    screen.PixelAt(box_.x_max, box_.y_max) = pixel_;
-
-    for (int x = box_.x_min + 1; x < box_.x_max; ++x) {
-      screen.PixelAt(x, box_.y_min) = pixel_;
-      screen.PixelAt(x, box_.y_max) = pixel_;
-    }
-    for (int y = box_.y_min + 1; y < box_.y_max; ++y) {
-      screen.PixelAt(box_.x_min, y) = pixel_;
-      screen.PixelAt(box_.x_max, y) = pixel_;
-    }
+    const Box& b = box_;
+    screen.Fill({b.x_min, b.x_max, b.y_min, b.y_min}, pixel_);
+    screen.Fill({b.x_min, b.x_max, b.y_max, b.y_max}, pixel_);
+    screen.Fill({b.x_min, b.x_min, b.y_min, b.y_max}, pixel_);
+    screen.Fill({b.x_max, b.x_max, b.y_min, b.y_max}, pixel_);
   }
 };
 }  // namespace
@@ -3,14 +3,19 @@
 // the LICENSE file.
 #include "ftxui/dom/canvas.hpp"
 
-#include <algorithm>               // for max, min
-#include <cmath>                   // for abs
-#include <cstdint>                 // for uint8_t
+#include <algorithm>               // for max, min, sort, copy, fill, find_if, rotate
+#include <array>                   // for array
+#include <climits>                 // for INT_MAX, INT_MIN
+#include <cmath>                   // for abs, ceil, floor
+#include <cstdint>                 // for int64_t, uint64_t, uint8_t
 #include <cstdlib>                 // for abs
+#include <cstring>                 // for memcpy
 #include <ftxui/screen/color.hpp>  // for Color
-#include <map>                     // for map
+#include <limits>                  // for numeric_limits
 #include <memory>                  // for make_shared
-#include <utility>                 // for move, pair
+#include <span>                    // for span
+#include <string>                  // for string
+#include <utility>                 // for exchange, move, pair
 #include <vector>                  // for vector
 
 #include "ftxui/dom/elements.hpp"     // for Element, canvas
@@ -25,10 +30,8 @@ namespace ftxui {
 
 namespace {
 
-// Base UTF8 pattern:
-// 11100010 10100000 10000000 // empty
-
-// Pattern for the individuel dots:
+// The braille characters are U+2800 + mask, where the mask bits are the
+// individual dots:
 // ┌──────┬───────┐
 // │dot1  │ dot4  │
 // ├──────┼───────┤
@@ -36,49 +39,95 @@ namespace {
 // ├──────┼───────┤
 // │dot3  │ dot6  │
 // ├──────┼───────┤
-// │dot0-1│ dot0-2│
+// │dot7  │ dot8  │
 // └──────┴───────┘
-// 11100010 10100000 10000001 // dot1
-// 11100010 10100000 10000010 // dot2
-// 11100010 10100000 10000100 // dot3
-// 11100010 10100001 10000000 // dot0-1
-// 11100010 10100000 10001000 // dot4
-// 11100010 10100000 10010000 // dot5
-// 11100010 10100000 10100000 // dot6
-// 11100010 10100010 10000000 // dot0-2
-
 // NOLINTNEXTLINE
-uint8_t g_map_braille[2][4][2] = {
-    {
-        {0b00000000, 0b00000001},  // NOLINT | dot1
-        {0b00000000, 0b00000010},  // NOLINT | dot2
-        {0b00000000, 0b00000100},  // NOLINT | dot3
-        {0b00000001, 0b00000000},  // NOLINT | dot0-1
-    },
-    {
-        {0b00000000, 0b00001000},  // NOLINT | dot4
-        {0b00000000, 0b00010000},  // NOLINT | dot5
-        {0b00000000, 0b00100000},  // NOLINT | dot6
-        {0b00000010, 0b00000000},  // NOLINT | dot0-2
-    },
+const uint8_t g_map_braille[2][4] = {
+    {0b00000001, 0b00000010, 0b00000100, 0b01000000},  // dot1 dot2 dot3 dot7
+    {0b00001000, 0b00010000, 0b00100000, 0b10000000},  // dot4 dot5 dot6 dot8
 };
 
+// Encode the braille character |mask| in UTF8:
+// 11100010 101000xx xxxxxxxx
+void BrailleToUtf8(uint8_t mask, std::string& out) {
+  const char utf8[3] = {
+      '\xE2',                                // NOLINT
+      static_cast<char>(0xA0 | (mask >> 6)),   // NOLINT
+      static_cast<char>(0x80 | (mask & 0x3F)), // NOLINT
+  };
+  out.assign(utf8, 3);
+}
+
 // NOLINTNEXTLINE
-std::vector<std::string> g_map_block = {
+const std::vector<std::string> g_map_block = {
     " ", "▘", "▖", "▌", "▝", "▀", "▞", "▛",
     "▗", "▚", "▄", "▙", "▐", "▜", "▟", "█",
 };
 
-// NOLINTNEXTLINE
-const std::map<std::string, uint8_t> g_map_block_inversed = {
-    {" ", 0b0000}, {"▘", 0b0001}, {"▖", 0b0010}, {"▌", 0b0011},
-    {"▝", 0b0100}, {"▀", 0b0101}, {"▞", 0b0110}, {"▛", 0b0111},
-    {"▗", 0b1000}, {"▚", 0b1001}, {"▄", 0b1010}, {"▙", 0b1011},
-    {"▐", 0b1100}, {"▜", 0b1101}, {"▟", 0b1110}, {"█", 0b1111},
-};
+// The bit of the block at (x, y), with y in half cells.
+uint8_t BlockBit(int x, int y) {
+  return 1U << ((x % 2) * 2 + y % 2);
+}
 
 constexpr auto nostyle = [](Pixel& /*pixel*/) {};
 
+bool SameStyle(const Pixel& a, const Pixel& b) {
+  return a.blink == b.blink && a.bold == b.bold && a.dim == b.dim &&
+         a.inverted == b.inverted && a.underlined == b.underlined &&
+         a.underlined_double == b.underlined_double &&
+         a.strikethrough == b.strikethrough && a.automerge == b.automerge &&
+         a.hyperlink == b.hyperlink &&
+         a.foreground_color == b.foreground_color &&
+         a.background_color == b.background_color &&
+         a.character == b.character;
+}
+
+// A byte representation of a Pixel, used to index the canvas styles.
+std::string StyleKey(const Pixel& pixel) {
+  static_assert(sizeof(Color) == 4, "Color is expected to be 4 bytes");
+  const uint8_t flags = uint8_t(pixel.blink << 0 | pixel.bold << 1 |      //
+                                pixel.dim << 2 | pixel.inverted << 3 |    //
+                                pixel.underlined << 4 |                   //
+                                pixel.underlined_double << 5 |            //
+                                pixel.strikethrough << 6 |                //
+                                pixel.automerge << 7);                    //
+  char key[2 + 2 * sizeof(Color)];
+  key[0] = static_cast<char>(flags);
+  key[1] = static_cast<char>(pixel.hyperlink);
+  std::memcpy(key + 2, &pixel.foreground_color, sizeof(Color));
+  std::memcpy(key + 2 + sizeof(Color), &pixel.background_color, sizeof(Color));
+  std::string out(key, sizeof(key));
+  out += pixel.character;
+  return out;
+}
+
+// Styles no longer used by any cell are garbage collected when their number
+// exceeds the number of cells by this amount.
+constexpr size_t kStylesSlack = 1024;
+
+// The state of the walk of Canvas::LineOn after |k| steps along the major
+// axis: the number of steps along the minor axis, and the error term. It is
+// computed directly, in 64 bits without overflow for any int coordinates.
+struct LineState {
+  int64_t minor_steps;
+  int64_t error;
+};
+LineState LineStateAt(int64_t k, int64_t dx, int64_t dy) {
+  if (dx >= dy) {
+    const uint64_t product = uint64_t(k + 1) * uint64_t(dy);
+    const auto quotient = int64_t(product / uint64_t(dx));
+    const auto remainder = int64_t(product % uint64_t(dx));
+    const int64_t steps =
+        std::min(k, quotient + (2 * remainder >= dx ? 1 : 0));
+    return {steps, dx - remainder + (steps - quotient) * dx};
+  }
+  const uint64_t product = uint64_t(k) * uint64_t(dx);
+  const auto quotient = int64_t(product / uint64_t(dy));
+  const auto remainder = int64_t(product % uint64_t(dy));
+  const int64_t steps = quotient + (2 * remainder >= dy ? 1 : 0);
+  return {steps, dx - dy + remainder + (quotient - steps) * dy};
+}
+
 }  // namespace
 
 /// @brief Constructor.
@@ -87,14 +136,189 @@ constexpr auto nostyle = [](Pixel& /*pixel*/) {};
 Canvas::Canvas(int width, int height)
     : width_(width),
       height_(height),
-      storage_(width_ * height_ / 8 /* NOLINT */) {}
+      cells_x_(std::max(0, (width + 1) / 2)),
+      cells_(size_t(cells_x_) * size_t(std::max(0, (height + 3) / 4))) {}
 
 /// @brief Get the content of a cell.
 /// @param x the x coordinate of the cell.
 /// @param y the y coordinate of the cell.
 Pixel Canvas::GetPixel(int x, int y) const {
-  auto it = storage_.find(XY{x, y});
-  return (it == storage_.end()) ? Pixel() : it->second.content;
+  if (x < 0 || y < 0 || x >= cells_x_ ||
+      size_t(y) * size_t(cells_x_) + size_t(x) >= cells_.size()) {
+    return Pixel();
+  }
+  Pixel pixel;
+  ToPixel(cells_[size_t(y) * size_t(cells_x_) + size_t(x)], pixel);
+  return pixel;
+}
+
+void Canvas::ToPixel(const Cell& cell, Pixel& pixel) const {
+  pixel = styles_[cell.style];
+  switch (cell.type) {
+    case kBraille:
+      BrailleToUtf8(cell.mask, pixel.character);
+      break;
+    case kBlock:
+      pixel.character = g_map_block[cell.mask];
+      break;
+    case kText:
+      break;
+  }
+}
+
+/// @brief Copy the canvas into |box| of |screen|, starting from its top-left
+/// corner. Only the part of |box| inside the stencil is written.
+/// @param screen the screen to draw into.
+/// @param box the area of the screen receiving the canvas.
+void Canvas::Blit(Screen& screen, const Box& box) const {
+  Box area = box;
+  area.x_max = std::min(area.x_max, box.x_min + width_ / 2 - 1);
+  area.y_max = std::min(area.y_max, box.y_min + height_ / 4 - 1);
+  area = Box::Intersection(area, screen.stencil);
+  for (int y = area.y_min; y <= area.y_max; ++y) {
+    const Cell* cell = cells_.data() +
+                       size_t(y - box.y_min) * size_t(cells_x_) +
+                       size_t(area.x_min - box.x_min);
+    screen.ForEachRow({area.x_min, area.x_max, y, y},
+                      [&](Pixel* begin, Pixel* end) {
+                        for (Pixel* pixel = begin; pixel != end; ++pixel) {
+                          ToPixel(*cell++, *pixel);
+                        }
+                      });
+  }
+}
+
+/// @brief Same as Blit, but reuse the pixels converted by the previous call.
+/// Only the cells modified in between are converted again.
+/// @param screen the screen to draw into.
+/// @param box the area of the screen receiving the canvas.
+void Canvas::BlitRetained(Screen& screen, const Box& box) const {
+  const int cells_y = cells_x_ ? int(cells_.size()) / cells_x_ : 0;
+  if (pixels_.size() != cells_.size()) {
+    pixels_.resize(cells_.size());
+    dirty_ = {0, cells_x_ - 1, 0, cells_y - 1};
+  }
+  dirty_ = Box::Intersection(dirty_, {0, cells_x_ - 1, 0, cells_y - 1});
+  for (int y = dirty_.y_min; y <= dirty_.y_max; ++y) {
+    for (int x = dirty_.x_min; x <= dirty_.x_max; ++x) {
+      const size_t index = size_t(y) * size_t(cells_x_) + size_t(x);
+      ToPixel(cells_[index], pixels_[index]);
+    }
+  }
+  dirty_ = {INT_MAX, INT_MIN, INT_MAX, INT_MIN};
+
+  Box area = box;
+  area.x_max = std::min(area.x_max, box.x_min + width_ / 2 - 1);
+  area.y_max = std::min(area.y_max, box.y_min + height_ / 4 - 1);
+  area = Box::Intersection(area, screen.stencil);
+  for (int y = area.y_min; y <= area.y_max; ++y) {
+    const Pixel* pixel = pixels_.data() +
+                         size_t(y - box.y_min) * size_t(cells_x_) +
+                         size_t(area.x_min - box.x_min);
+    screen.ForEachRow({area.x_min, area.x_max, y, y},
+                      [&](Pixel* begin, Pixel* end) {
+                        std::copy(pixel, pixel + (end - begin), begin);
+                      });
+  }
+}
+
+/// @brief Erase every cell, keeping the memory allocated.
+void Canvas::Clear() {
+  std::fill(cells_.begin(), cells_.end(), Cell());
+  styles_.resize(1);
+  styles_index_.clear();
+  last_style_ = 0;
+  ++styles_generation_;
+  const int cells_y = cells_x_ ? int(cells_.size()) / cells_x_ : 0;
+  dirty_ = {0, cells_x_ - 1, 0, cells_y - 1};
+}
+
+Canvas::Cell& Canvas::BrailleCellAt(int x, int y) {
+  Cell& cell = CellAt(x, y);
+  if (cell.type != kBraille) {
+    cell.type = kBraille;
+    cell.mask = 0;
+  }
+  return cell;
+}
+
+Canvas::Cell& Canvas::BlockCellAt(int x, int y) {
+  Cell& cell = CellAt(x, y);
+  if (cell.type != kBlock) {
+    cell.type = kBlock;
+    cell.mask = 0;
+  }
+  return cell;
+}
+
+uint32_t Canvas::Intern(const Pixel& pixel) {
+  if (SameStyle(pixel, styles_[last_style_])) {
+    return last_style_;
+  }
+  if (SameStyle(pixel, styles_[0])) {
+    return last_style_ = 0;
+  }
+
+  std::string key = StyleKey(pixel);
+  auto it = styles_index_.find(key);
+  if (it != styles_index_.end()) {
+    return last_style_ = it->second;
+  }
+
+  if (styles_.size() > cells_.size() + kStylesSlack) {
+    CompactStyles();
+  }
+  last_style_ = static_cast<uint32_t>(styles_.size());
+  styles_.push_back(pixel);
+  styles_index_.emplace(std::move(key), last_style_);
+  return last_style_;
+}
+
+void Canvas::CompactStyles() {
+  constexpr uint32_t unused = std::numeric_limits<uint32_t>::max();
+  std::vector<uint32_t> remap(styles_.size(), unused);
+  std::vector<Pixel> styles = {styles_[0]};
+  remap[0] = 0;
+  styles_index_.clear();
+  for (Cell& cell : cells_) {
+    uint32_t& index = remap[cell.style];
+    if (index == unused) {
+      index = static_cast<uint32_t>(styles.size());
+      styles.push_back(std::move(styles_[cell.style]));
+      styles_index_.emplace(StyleKey(styles.back()), index);
+    }
+    cell.style = index;
+  }
+  styles_ = std::move(styles);
+  last_style_ = 0;
+  ++styles_generation_;
+}
+
+void Canvas::Restyle(Cell& cell, Brush& brush) {
+  if (!brush.color && !brush.style) {
+    return;
+  }
+  if (brush.generation == styles_generation_ &&
+      (brush.from == cell.style || brush.to == cell.style)) {
+    cell.style = brush.to;
+    return;
+  }
+  Pixel pixel = styles_[cell.style];
+  if (brush.color) {
+    pixel.foreground_color = *brush.color;
+  } else {
+    (*brush.style)(pixel);
+  }
+  if (cell.type != kText) {
+    pixel.character = " ";
+  }
+  const uint32_t generation = styles_generation_;
+  const uint32_t from = cell.style;
+  cell.style = Intern(pixel);
+  // Interning might have compacted the styles, invalidating |from|.
+  brush.generation = styles_generation_;
+  brush.from = (generation == styles_generation_) ? from : UINT32_MAX;
+  brush.to = cell.style;
 }
 
 /// @brief Draw a braille dot.
@@ -102,7 +326,11 @@ Pixel Canvas::GetPixel(int x, int y) const {
 /// @param y the y coordinate of the dot.
 /// @param value whether the dot is filled or not.
 void Canvas::DrawPoint(int x, int y, bool value) {
-  DrawPoint(x, y, value, [](Pixel& /*pixel*/) {});
+  if (value) {
+    DrawPointOn(x, y);
+  } else {
+    DrawPointOff(x, y);
+  }
 }
 
 /// @brief Draw a braille dot.
@@ -135,14 +363,7 @@ void Canvas::DrawPointOn(int x, int y) {
   if (!IsIn(x, y)) {
     return;
   }
-  Cell& cell = storage_[XY{x / 2, y / 4}];
-  if (cell.type != CellType::kBraille) {
-    cell.content.character = "⠀";  // 3 bytes.
-    cell.type = CellType::kBraille;
-  }
-
-  cell.content.character[1] |= g_map_braille[x % 2][y % 4][0];  // NOLINT
-  cell.content.character[2] |= g_map_braille[x % 2][y % 4][1];  // NOLINT
+  BrailleCellAt(x, y).mask |= g_map_braille[x % 2][y % 4];
 }
 
 /// @brief Erase a braille dot.
@@ -152,14 +373,7 @@ void Canvas::DrawPointOff(int x, int y) {
   if (!IsIn(x, y)) {
     return;
   }
-  Cell& cell = storage_[XY{x / 2, y / 4}];
-  if (cell.type != CellType::kBraille) {
-    cell.content.character = "⠀";  // 3 byt
-    cell.type = CellType::kBraille;
-  }
-
-  cell.content.character[1] &= ~(g_map_braille[x % 2][y % 4][0]);  // NOLINT
-  cell.content.character[2] &= ~(g_map_braille[x % 2][y % 4][1]);  // NOLINT
+  BrailleCellAt(x, y).mask &= ~g_map_braille[x % 2][y % 4];
 }
 
 /// @brief Toggle a braille dot. A filled one will be erased, and the other will
@@ -170,14 +384,7 @@ void Canvas::DrawPointToggle(int x, int y) {
   if (!IsIn(x, y)) {
     return;
   }
-  Cell& cell = storage_[XY{x / 2, y / 4}];
-  if (cell.type != CellType::kBraille) {
-    cell.content.character = "⠀";  // 3 byt
-    cell.type = CellType::kBraille;
-  }
-
-  cell.content.character[1] ^= g_map_braille[x % 2][y % 4][0];  // NOLINT
-  cell.content.character[2] ^= g_map_braille[x % 2][y % 4][1];  // NOLINT
+  BrailleCellAt(x, y).mask ^= g_map_braille[x % 2][y % 4];
 }
 
 /// @brief Draw a line made of braille dots.
@@ -239,6 +446,452 @@ void Canvas::DrawPointLine(int x1,
   DrawPoint(x2, y2, true, style);
 }
 
+void Canvas::DotOn(int x, int y, Brush& brush) {
+  if (!IsIn(x, y)) {
+    return;
+  }
+  Cell& cell = BrailleCellAt(x, y);
+  cell.mask |= g_map_braille[x % 2][y % 4];
+  Restyle(cell, brush);
+}
+
+void Canvas::BlockOn(int x, int y, Brush& brush) {
+  if (!IsIn(x, y)) {
+    return;
+  }
+  Cell& cell = BlockCellAt(x, y);
+  cell.mask |= BlockBit(x, y / 2);
+  Restyle(cell, brush);
+}
+
+void Canvas::LineOn(Point a, Point b, Brush& brush, Plot plot) {
+  // Lines entirely on one side of the canvas are skipped.
+  if ((a.x < 0 && b.x < 0) || (a.y < 0 && b.y < 0) ||
+      (a.x >= width_ && b.x >= width_) || (a.y >= height_ && b.y >= height_)) {
+    return;
+  }
+
+  const int64_t dx = std::abs(int64_t(b.x) - a.x);
+  const int64_t dy = std::abs(int64_t(b.y) - a.y);
+  const int64_t sx = a.x < b.x ? 1 : -1;
+  const int64_t sy = a.y < b.y ? 1 : -1;
+
+  // The walk takes one step along the major axis at a time. It is clipped to
+  // the steps inside the canvas, starting from the state of the first one. The
+  // dots drawn are the same as without clipping.
+  const bool x_major = dx >= dy;
+  const int64_t length = std::max(dx, dy);
+  const int64_t major_start = x_major ? a.x : a.y;
+  const int64_t major_sign = x_major ? sx : sy;
+  const int64_t major_size = x_major ? width_ : height_;
+  const int64_t minor_start = x_major ? a.y : a.x;
+  const int64_t minor_sign = x_major ? sy : sx;
+  const int64_t minor_size = x_major ? height_ : width_;
+
+  int64_t first = 0;
+  int64_t last = length - 1;
+  if (major_sign > 0) {
+    first = std::max(first, -major_start);
+    last = std::min(last, major_size - 1 - major_start);
+  } else {
+    first = std::max(first, major_start - (major_size - 1));
+    last = std::min(last, major_start);
+  }
+
+  // The steps along the minor axis only increase. The range keeping the
+  // minor coordinate inside is found by bisection.
+  const int64_t low = minor_sign > 0 ? -minor_start
+                                     : minor_start - (minor_size - 1);
+  const int64_t high = minor_sign > 0 ? minor_size - 1 - minor_start
+                                      : minor_start;
+  if (first <= last) {
+    int64_t begin = first;
+    int64_t end = last + 1;
+    while (begin < end) {
+      const int64_t middle = begin + (end - begin) / 2;
+      if (LineStateAt(middle, dx, dy).minor_steps >= low) {
+        end = middle;
+      } else {
+        begin = middle + 1;
+      }
+    }
+    first = begin;
+    begin = first - 1;
+    end = last;
+    while (begin < end) {
+      const int64_t middle = begin + (end - begin + 1) / 2;
+      if (LineStateAt(middle, dx, dy).minor_steps <= high) {
+        begin = middle;
+      } else {
+        end = middle - 1;
+      }
+    }
+    last = begin;
+  }
+
+  if (first <= last) {
+    const LineState state = LineStateAt(first, dx, dy);
+    int64_t x = a.x + sx * (x_major ? first : state.minor_steps);
+    int64_t y = a.y + sy * (x_major ? state.minor_steps : first);
+    int64_t error = state.error;
+    for (int64_t i = first; i <= last; ++i) {
+      (this->*plot)(int(x), int(y), brush);
+      if (2 * error >= -dy) {
+        error -= dy;
+        x += sx;
+      }
+      if (2 * error <= dx) {
+        error += dx;
+        y += sy;
+      }
+    }
+  }
+  (this->*plot)(b.x, b.y, brush);
+}
+
+void Canvas::PointsOn(std::span<const Point> points, Brush brush) {
+  for (const Point& point : points) {
+    DotOn(point.x, point.y, brush);
+  }
+}
+
+void Canvas::PolylineOn(std::span<const Point> points, Brush brush) {
+  if (points.size() == 1) {
+    DotOn(points[0].x, points[0].y, brush);
+  }
+  for (size_t i = 1; i < points.size(); ++i) {
+    LineOn(points[i - 1], points[i], brush);
+  }
+}
+
+void Canvas::SegmentsOn(std::span<const Point> points, Brush brush) {
+  for (size_t i = 1; i < points.size(); i += 2) {
+    LineOn(points[i - 1], points[i], brush);
+  }
+}
+
+void Canvas::ScatterOn(int x, std::span<const int> ys, Brush brush) {
+  // Only the samples whose x coordinate lies within the canvas are visited.
+  const int first = std::max(0, -x);
+  const int last = std::min(static_cast<int>(ys.size()), width_ - x);
+  for (int i = first; i < last; ++i) {
+    DotOn(x + i, ys[i], brush);
+  }
+}
+
+/// @brief Draw braille dots.
+/// @param points the coordinates of the dots.
+void Canvas::DrawPoints(std::span<const Point> points) {
+  PointsOn(points, Brush());
+}
+
+/// @brief Draw braille dots.
+/// @param points the coordinates of the dots.
+/// @param style the style of the cells drawn.
+void Canvas::DrawPoints(std::span<const Point> points,
+                        const Stylizer& style) {
+  Brush brush;
+  brush.style = &style;
+  PointsOn(points, brush);
+}
+
+/// @brief Draw braille dots.
+/// @param points the coordinates of the dots.
+/// @param color the color of the dots.
+void Canvas::DrawPoints(std::span<const Point> points, const Color& color) {
+  Brush brush;
+  brush.color = &color;
+  PointsOn(points, brush);
+}
+
+/// @brief Draw lines made of braille dots, linking consecutive points.
+/// @param points the vertices of the polyline.
+void Canvas::DrawPolyline(std::span<const Point> points) {
+  PolylineOn(points, Brush());
+}
+
+/// @brief Draw lines made of braille dots, linking consecutive points.
+/// @param points the vertices of the polyline.
+/// @param style the style of the cells drawn.
+void Canvas::DrawPolyline(std::span<const Point> points,
+                          const Stylizer& style) {
+  Brush brush;
+  brush.style = &style;
+  PolylineOn(points, brush);
+}
+
+/// @brief Draw lines made of braille dots, linking consecutive points.
+/// @param points the vertices of the polyline.
+/// @param color the color of the lines.
+void Canvas::DrawPolyline(std::span<const Point> points, const Color& color) {
+  Brush brush;
+  brush.color = &color;
+  PolylineOn(points, brush);
+}
+
+/// @brief Draw lines made of braille dots, one per pair of points.
+/// @param points the end points of the segments. A last unpaired point is
+/// ignored.
+void Canvas::DrawSegments(std::span<const Point> points) {
+  SegmentsOn(points, Brush());
+}
+
+/// @brief Draw lines made of braille dots, one per pair of points.
+/// @param points the end points of the segments. A last unpaired point is
+/// ignored.
+/// @param style the style of the cells drawn.
+void Canvas::DrawSegments(std::span<const Point> points,
+                          const Stylizer& style) {
+  Brush brush;
+  brush.style = &style;
+  SegmentsOn(points, brush);
+}
+
+/// @brief Draw lines made of braille dots, one per pair of points.
+/// @param points the end points of the segments. A last unpaired point is
+/// ignored.
+/// @param color the color of the lines.
+void Canvas::DrawSegments(std::span<const Point> points, const Color& color) {
+  Brush brush;
+  brush.color = &color;
+  SegmentsOn(points, brush);
+}
+
+/// @brief Draw one braille dot per sample.
+/// @param x the x coordinate of the first sample.
+/// @param ys the y coordinate of the samples. The sample i is drawn at x + i.
+void Canvas::DrawScatter(int x, std::span<const int> ys) {
+  ScatterOn(x, ys, Brush());
+}
+
+/// @brief Draw one braille dot per sample.
+/// @param x the x coordinate of the first sample.
+/// @param ys the y coordinate of the samples. The sample i is drawn at x + i.
+/// @param style the style of the cells drawn.
+void Canvas::DrawScatter(int x,
+                         std::span<const int> ys,
+                         const Stylizer& style) {
+  Brush brush;
+  brush.style = &style;
+  ScatterOn(x, ys, brush);
+}
+
+/// @brief Draw one braille dot per sample.
+/// @param x the x coordinate of the first sample.
+/// @param ys the y coordinate of the samples. The sample i is drawn at x + i.
+/// @param color the color of the dots.
+void Canvas::DrawScatter(int x, std::span<const int> ys, const Color& color) {
+  Brush brush;
+  brush.color = &color;
+  ScatterOn(x, ys, brush);
+}
+
+// Fill a polygon, one row of cells at a time. Each row of cells is made of 4
+// rows of braille dots, or 2 rows of blocks. The spans of every sub-row are
+// accumulated into per cell masks, and the cells are then written once.
+void Canvas::PolygonOn(const std::vector<Point>& points,
+                       bool block,
+                       Brush brush) {
+  if (points.empty()) {
+    return;
+  }
+  const int sub_rows = block ? 2 : 4;  // Per row of cells.
+  const int scale = block ? 2 : 1;     // Canvas y per sub-row.
+  const Plot plot = block ? &Canvas::BlockOn : &Canvas::DotOn;
+
+  int y_min = INT_MAX;
+  int y_max = INT_MIN;
+  for (const Point& point : points) {
+    y_min = std::min(y_min, point.y);
+    y_max = std::max(y_max, point.y);
+  }
+  const int s_min = std::max(0, (y_min + scale - 1) / scale);
+  const int s_max = std::min((height_ - 1) / scale, y_max / scale);
+
+  std::vector<uint8_t> masks(size_t(cells_x_), 0);
+  std::vector<double> xs;
+  for (int cell_y = s_min / sub_rows; cell_y <= s_max / sub_rows; ++cell_y) {
+    int first = INT_MAX;
+    int last = INT_MIN;
+    for (int r = 0; r < sub_rows; ++r) {
+      const int s = cell_y * sub_rows + r;
+      if (s < s_min || s > s_max) {
+        continue;
+      }
+
+      // Intersect the sub-row with every edge.
+      const double y = s * scale;
+      xs.clear();
+      for (size_t i = 0; i < points.size(); ++i) {
+        const Point& a = points[i];
+        const Point& b = points[(i + 1) % points.size()];
+        if ((a.y <= y) != (b.y <= y)) {
+          xs.push_back(a.x + (y - a.y) * (b.x - a.x) / (b.y - a.y));
+        }
+      }
+      std::sort(xs.begin(), xs.end());
+
+      // Accumulate the spans in between pairs of intersections.
+      const uint8_t left = block ? BlockBit(0, r) : g_map_braille[0][r];
+      const uint8_t right = block ? BlockBit(1, r) : g_map_braille[1][r];
+      for (size_t i = 0; i + 1 < xs.size(); i += 2) {
+        const int x0 = std::max(0, static_cast<int>(std::ceil(xs[i])));
+        const int x1 =
+            std::min(width_ - 1, static_cast<int>(std::floor(xs[i + 1])));
+        if (x0 > x1) {
+          continue;
+        }
+        for (int x = x0 / 2; x <= x1 / 2; ++x) {
+          masks[x] |= (2 * x >= x0 ? left : 0) |  //
+                      (2 * x + 1 <= x1 ? right : 0);
+        }
+        first = std::min(first, x0 / 2);
+        last = std::max(last, x1 / 2);
+      }
+    }
+
+    for (int x = first; x <= last; ++x) {
+      if (!masks[x]) {
+        continue;
+      }
+      Cell& cell = block ? BlockCellAt(2 * x, 4 * cell_y)
+                         : BrailleCellAt(2 * x, 4 * cell_y);
+      cell.mask |= masks[x];
+      masks[x] = 0;
+      Restyle(cell, brush);
+    }
+  }
+
+  // The edges are drawn, so that the boundary is part of the polygon.
+  for (size_t i = 0; i < points.size(); ++i) {
+    LineOn(points[i], points[(i + 1) % points.size()], brush, plot);
+  }
+}
+
+/// @brief Draw a filled polygon made of braille dots.
+/// @param points the vertices of the polygon.
+void Canvas::DrawPointPolygonFilled(const std::vector<Point>& points) {
+  PolygonOn(points, /*block=*/false, Brush());
+}
+
+/// @brief Draw a filled polygon made of braille dots.
+/// @param points the vertices of the polygon.
+/// @param style the style of the polygon.
+void Canvas::DrawPointPolygonFilled(const std::vector<Point>& points,
+                                    const Stylizer& style) {
+  Brush brush;
+  brush.style = &style;
+  PolygonOn(points, /*block=*/false, brush);
+}
+
+/// @brief Draw a filled polygon made of braille dots.
+/// @param points the vertices of the polygon.
+/// @param color the color of the polygon.
+void Canvas::DrawPointPolygonFilled(const std::vector<Point>& points,
+                                    const Color& color) {
+  Brush brush;
+  brush.color = &color;
+  PolygonOn(points, /*block=*/false, brush);
+}
+
+/// @brief Draw a filled triangle made of braille dots.
+/// @param a the first vertex of the triangle.
+/// @param b the second vertex of the triangle.
+/// @param c the third vertex of the triangle.
+void Canvas::DrawPointTriangleFilled(Point a, Point b, Point c) {
+  PolygonOn({a, b, c}, /*block=*/false, Brush());
+}
+
+/// @brief Draw a filled triangle made of braille dots.
+/// @param a the first vertex of the triangle.
+/// @param b the second vertex of the triangle.
+/// @param c the third vertex of the triangle.
+/// @param style the style of the triangle.
+void Canvas::DrawPointTriangleFilled(Point a,
+                                     Point b,
+                                     Point c,
+                                     const Stylizer& style) {
+  Brush brush;
+  brush.style = &style;
+  PolygonOn({a, b, c}, /*block=*/false, brush);
+}
+
+/// @brief Draw a filled triangle made of braille dots.
+/// @param a the first vertex of the triangle.
+/// @param b the second vertex of the triangle.
+/// @param c the third vertex of the triangle.
+/// @param color the color of the triangle.
+void Canvas::DrawPointTriangleFilled(Point a,
+                                     Point b,
+                                     Point c,
+                                     const Color& color) {
+  Brush brush;
+  brush.color = &color;
+  PolygonOn({a, b, c}, /*block=*/false, brush);
+}
+
+/// @brief Draw a filled polygon made of block characters.
+/// @param points the vertices of the polygon.
+void Canvas::DrawBlockPolygonFilled(const std::vector<Point>& points) {
+  PolygonOn(points, /*block=*/true, Brush());
+}
+
+/// @brief Draw a filled polygon made of block characters.
+/// @param points the vertices of the polygon.
+/// @param style the style of the polygon.
+void Canvas::DrawBlockPolygonFilled(const std::vector<Point>& points,
+                                    const Stylizer& style) {
+  Brush brush;
+  brush.style = &style;
+  PolygonOn(points, /*block=*/true, brush);
+}
+
+/// @brief Draw a filled polygon made of block characters.
+/// @param points the vertices of the polygon.
+/// @param color the color of the polygon.
+void Canvas::DrawBlockPolygonFilled(const std::vector<Point>& points,
+                                    const Color& color) {
+  Brush brush;
+  brush.color = &color;
+  PolygonOn(points, /*block=*/true, brush);
+}
+
+/// @brief Draw a filled triangle made of block characters.
+/// @param a the first vertex of the triangle.
+/// @param b the second vertex of the triangle.
+/// @param c the third vertex of the triangle.
+void Canvas::DrawBlockTriangleFilled(Point a, Point b, Point c) {
+  PolygonOn({a, b, c}, /*block=*/true, Brush());
+}
+
+/// @brief Draw a filled triangle made of block characters.
+/// @param a the first vertex of the triangle.
+/// @param b the second vertex of the triangle.
+/// @param c the third vertex of the triangle.
+/// @param style the style of the triangle.
+void Canvas::DrawBlockTriangleFilled(Point a,
+                                     Point b,
+                                     Point c,
+                                     const Stylizer& style) {
+  Brush brush;
+  brush.style = &style;
+  PolygonOn({a, b, c}, /*block=*/true, brush);
+}
+
+/// @brief Draw a filled triangle made of block characters.
+/// @param a the first vertex of the triangle.
+/// @param b the second vertex of the triangle.
+/// @param c the third vertex of the triangle.
+/// @param color the color of the triangle.
+void Canvas::DrawBlockTriangleFilled(Point a,
+                                     Point b,
+                                     Point c,
+                                     const Color& color) {
+  Brush brush;
+  brush.color = &color;
+  PolygonOn({a, b, c}, /*block=*/true, brush);
+}
+
 /// @brief Draw a circle made of braille dots.
 /// @param x the x coordinate of the center of the circle.
 /// @param y the y coordinate of the center of the circle.
@@ -433,7 +1086,11 @@ void Canvas::DrawPointEllipseFilled(int x1,
 /// @param y the y coordinate of the block.
 /// @param value whether the block is filled or not.
 void Canvas::DrawBlock(int x, int y, bool value) {
-  DrawBlock(x, y, value, [](Pixel& /*pixel*/) {});
+  if (value) {
+    DrawBlockOn(x, y);
+  } else {
+    DrawBlockOff(x, y);
+  }
 }
 
 /// @brief Draw a block.
@@ -466,17 +1123,7 @@ void Canvas::DrawBlockOn(int x, int y) {
   if (!IsIn(x, y)) {
     return;
   }
-  y /= 2;
-  Cell& cell = storage_[XY{x / 2, y / 2}];
-  if (cell.type != CellType::kBlock) {
-    cell.content.character = " ";
-    cell.type = CellType::kBlock;
-  }
-
-  const uint8_t bit = (x % 2) * 2 + y % 2;
-  uint8_t value = g_map_block_inversed.at(cell.content.character);
-  value |= 1U << bit;
-  cell.content.character = g_map_block[value];
+  BlockCellAt(x, y).mask |= BlockBit(x, y / 2);
 }
 
 /// @brief Erase a block.
@@ -486,17 +1133,7 @@ void Canvas::DrawBlockOff(int x, int y) {
   if (!IsIn(x, y)) {
     return;
   }
-  Cell& cell = storage_[XY{x / 2, y / 4}];
-  if (cell.type != CellType::kBlock) {
-    cell.content.character = " ";
-    cell.type = CellType::kBlock;
-  }
-  y /= 2;
-
-  const uint8_t bit = (y % 2) * 2 + x % 2;
-  uint8_t value = g_map_block_inversed.at(cell.content.character);
-  value &= ~(1U << bit);
-  cell.content.character = g_map_block[value];
+  BlockCellAt(x, y).mask &= ~BlockBit(x, y / 2);
 }
 
 /// @brief Toggle a block. If it is filled, it will be erased. If it is empty,
@@ -507,17 +1144,7 @@ void Canvas::DrawBlockToggle(int x, int y) {
   if (!IsIn(x, y)) {
     return;
   }
-  Cell& cell = storage_[XY{x / 2, y / 4}];
-  if (cell.type != CellType::kBlock) {
-    cell.content.character = " ";
-    cell.type = CellType::kBlock;
-  }
-  y /= 2;
-
-  const uint8_t bit = (y % 2) * 2 + x % 2;
-  uint8_t value = g_map_block_inversed.at(cell.content.character);
-  value ^= 1U << bit;
-  cell.content.character = g_map_block[value];
+  BlockCellAt(x, y).mask ^= BlockBit(x, y / 2);
 }
 
 /// @brief Draw a line made of block characters.
@@ -809,10 +1436,13 @@ void Canvas::DrawText(int x,
       x += 2;
       continue;
     }
-    Cell& cell = storage_[XY{x / 2, y / 4}];
-    cell.type = CellType::kText;
-    cell.content.character = it;
-    style(cell.content);
+    Cell& cell = CellAt(x, y);
+    Pixel pixel = styles_[cell.style];
+    pixel.character = it;
+    style(pixel);
+    cell.type = kText;
+    cell.mask = 0;
+    cell.style = Intern(pixel);
     x += 2;
   }
 }
@@ -820,9 +1450,17 @@ void Canvas::DrawText(int x,
 /// @brief Modify a pixel at a given location.
 /// @param style a function that modifies the pixel.
 void Canvas::Style(int x, int y, const Stylizer& style) {
-  if (IsIn(x, y)) {
-    style(storage_[XY{x / 2, y / 4}].content);
+  if (!IsIn(x, y)) {
+    return;
+  }
+  Cell& cell = CellAt(x, y);
+  Pixel pixel = styles_[cell.style];
+  style(pixel);
+  // Only text cells store their glyph.
+  if (cell.type != kText) {
+    pixel.character = " ";
   }
+  cell.style = Intern(pixel);
 }
 
 namespace {
@@ -831,20 +1469,50 @@ class CanvasNodeBase : public Node {
  public:
   CanvasNodeBase() = default;
 
-  void Render(Screen& screen) override {
-    const Canvas& c = canvas();
-    const int y_max = std::min(c.height() / 4, box_.y_max - box_.y_min + 1);
-    const int x_max = std::min(c.width() / 2, box_.x_max - box_.x_min + 1);
-    for (int y = 0; y < y_max; ++y) {
-      for (int x = 0; x < x_max; ++x) {
-        screen.PixelAt(box_.x_min + x, box_.y_min + y) = c.GetPixel(x, y);
+  void Render(Screen& screen) override { canvas().Blit(screen, box_); }
+
+  virtual const Canvas& canvas() = 0;
+};
+
+// The canvases of the canvas(width, height, fn) elements destroyed, keyed by
+// their size. The elements are rebuilt every frame, and the ones of the next
+// frame reuse their memory. Only the |kSpares| sizes most recently given back
+// are kept.
+class SpareCanvases {
+ public:
+  // Take the canvas of this size, or a new one.
+  Canvas Take(int width, int height) {
+    for (Canvas& spare : spares_) {
+      if (spare.width() == width && spare.height() == height) {
+        return std::exchange(spare, Canvas());
       }
     }
+    return Canvas(width, height);
   }
 
-  virtual const Canvas& canvas() = 0;
+  // Keep |canvas| first, in place of the one of the same size, of an empty
+  // slot, or of the least recently given back.
+  void Give(Canvas canvas) {
+    auto slot = std::find_if(spares_.begin(), spares_.end() - 1,
+                             [&](const Canvas& spare) {
+                               return spare.width() == 0 ||
+                                      (spare.width() == canvas.width() &&
+                                       spare.height() == canvas.height());
+                             });
+    std::rotate(spares_.begin(), slot, slot + 1);
+    spares_.front() = std::move(canvas);
+  }
+
+ private:
+  static constexpr size_t kSpares = 4;
+  std::array<Canvas, kSpares> spares_;
 };
 
+SpareCanvases& GetSpareCanvases() {
+  thread_local SpareCanvases spares;
+  return spares;
+}
+
 }  // namespace
 
 /// @brief Produce an element from a Canvas, or a reference to a Canvas.
@@ -862,15 +1530,43 @@ Element canvas(ConstRef<Canvas> canvas) {
   return std::make_shared<Impl>(canvas);
 }
 
+/// @brief Produce an element from a Canvas kept in between frames. Only the
+/// cells modified since the previous frame are converted again.
+/// @param canvas the canvas. It is meant to be a reference.
+// NOLINTNEXTLINE
+Element canvasRetained(ConstRef<Canvas> canvas) {
+  class Impl : public CanvasNodeBase {
+   public:
+    explicit Impl(ConstRef<Canvas> canvas) : canvas_(std::move(canvas)) {
+      requirement_.min_x = (canvas_->width() + 1) / 2;
+      requirement_.min_y = (canvas_->height() + 3) / 4;
+    }
+    void Render(Screen& screen) final { canvas_->BlitRetained(screen, box_); }
+    const Canvas& canvas() final { return *canvas_; }
+    ConstRef<Canvas> canvas_;
+  };
+  return std::make_shared<Impl>(canvas);
+}
+
 /// @brief Produce an element drawing a canvas of requested size.
 /// @param width the width of the canvas.
 /// @param height the height of the canvas.
-/// @param fn a function drawing the canvas.
+/// @param fn a function drawing the canvas. It receives a cleared canvas.
+/// @note The elements are rebuilt every frame. To avoid allocating, each
+/// thread keeps the canvases of the last 4 sizes drawn, for the elements of
+/// the next frame. Their memory is kept until the thread exits.
 Element canvas(int width, int height, std::function<void(Canvas&)> fn) {
   class Impl : public CanvasNodeBase {
    public:
     Impl(int width, int height, std::function<void(Canvas&)> fn)
         : width_(width), height_(height), fn_(std::move(fn)) {}
+    Impl(const Impl&) = delete;
+    Impl& operator=(const Impl&) = delete;
+    ~Impl() override {
+      if (canvas_.width() && canvas_.height()) {
+        GetSpareCanvases().Give(std::move(canvas_));
+      }
+    }
 
     void ComputeRequirement() final {
       requirement_.min_x = (width_ + 1) / 2;
@@ -880,7 +1576,13 @@ Element canvas(int width, int height, std::function<void(Canvas&)> fn) {
     void Render(Screen& screen) final {
       const int width = (box_.x_max - box_.x_min + 1) * 2;
       const int height = (box_.y_max - box_.y_min + 1) * 4;
-      canvas_ = Canvas(width, height);
+      if (canvas_.width() != width || canvas_.height() != height) {
+        if (canvas_.width() && canvas_.height()) {
+          GetSpareCanvases().Give(std::move(canvas_));
+        }
+        canvas_ = GetSpareCanvases().Take(width, height);
+      }
+      canvas_.Clear();
       fn_(canvas_);
       CanvasNodeBase::Render(screen);
     }
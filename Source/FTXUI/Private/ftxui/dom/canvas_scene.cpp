@@ -0,0 +1,358 @@
+// Copyright 2021 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include "ftxui/dom/canvas_scene.hpp"
+
+#include <algorithm>  // for clamp, max, min, fill
+#include <cmath>      // for floor, isfinite, lround, sqrt
+#include <cstddef>    // for size_t
+#include <cstdint>    // for uint32_t
+#include <vector>     // for vector
+
+#include "ftxui/dom/canvas.hpp"    // for Canvas
+#include "ftxui/screen/color.hpp"  // for Color
+
+namespace ftxui {
+
+namespace {
+
+// Primitives whose bounds cover more buckets than this are kept aside, and
+// visited on every draw.
+constexpr int kMaxBucketsPerPrimitive = 16;
+
+// Cohen-Sutherland clipping of a segment against the view.
+struct ClipRect {
+  double x_min;
+  double x_max;
+  double y_min;
+  double y_max;
+};
+
+enum ClipCode : int {
+  kClipInside = 0,
+  kClipLeft = 1,
+  kClipRight = 2,
+  kClipBottom = 4,
+  kClipTop = 8,
+};
+
+int ComputeClipCode(double x, double y, const ClipRect& rect) {
+  int code = kClipInside;
+  if (x < rect.x_min) {
+    code |= kClipLeft;
+  } else if (x > rect.x_max) {
+    code |= kClipRight;
+  }
+  if (y < rect.y_min) {
+    code |= kClipBottom;
+  } else if (y > rect.y_max) {
+    code |= kClipTop;
+  }
+  return code;
+}
+
+// Clip the segment in place. Return false when nothing is left.
+bool ClipSegment(double& x1,
+                 double& y1,
+                 double& x2,
+                 double& y2,
+                 const ClipRect& rect) {
+  int code1 = ComputeClipCode(x1, y1, rect);
+  int code2 = ComputeClipCode(x2, y2, rect);
+  while (true) {
+    if (!(code1 | code2)) {
+      return true;
+    }
+    if (code1 & code2) {
+      return false;
+    }
+
+    const int code = code1 ? code1 : code2;
+    double x = 0.0;
+    double y = 0.0;
+    if (code & kClipTop) {
+      x = x1 + (x2 - x1) * (rect.y_max - y1) / (y2 - y1);
+      y = rect.y_max;
+    } else if (code & kClipBottom) {
+      x = x1 + (x2 - x1) * (rect.y_min - y1) / (y2 - y1);
+      y = rect.y_min;
+    } else if (code & kClipRight) {
+      y = y1 + (y2 - y1) * (rect.x_max - x1) / (x2 - x1);
+      x = rect.x_max;
+    } else {
+      y = y1 + (y2 - y1) * (rect.x_min - x1) / (x2 - x1);
+      x = rect.x_min;
+    }
+
+    if (code == code1) {
+      x1 = x;
+      y1 = y;
+      code1 = ComputeClipCode(x1, y1, rect);
+    } else {
+      x2 = x;
+      y2 = y;
+      code2 = ComputeClipCode(x2, y2, rect);
+    }
+  }
+}
+
+}  // namespace
+
+/// @brief Add a point.
+/// @param x the x coordinate of the point, in world coordinates.
+/// @param y the y coordinate of the point, in world coordinates.
+/// @param color the color of the point.
+/// @note A point with a non finite coordinate is ignored.
+void CanvasScene::AddPoint(double x, double y, const Color& color) {
+  if (!std::isfinite(x) || !std::isfinite(y)) {
+    return;
+  }
+  primitives_.push_back({x, y, x, y, color});
+  index_valid_ = false;
+}
+
+/// @brief Add a line.
+/// @param x1 the x coordinate of the first end, in world coordinates.
+/// @param y1 the y coordinate of the first end, in world coordinates.
+/// @param x2 the x coordinate of the second end, in world coordinates.
+/// @param y2 the y coordinate of the second end, in world coordinates.
+/// @param color the color of the line.
+/// @note A line with a non finite coordinate is ignored.
+void CanvasScene::AddLine(double x1,
+                          double y1,
+                          double x2,
+                          double y2,
+                          const Color& color) {
+  if (!std::isfinite(x1) || !std::isfinite(y1) || !std::isfinite(x2) ||
+      !std::isfinite(y2)) {
+    return;
+  }
+  primitives_.push_back({x1, y1, x2, y2, color});
+  index_valid_ = false;
+}
+
+/// @brief Remove every primitive.
+void CanvasScene::Clear() {
+  primitives_.clear();
+  index_valid_ = false;
+}
+
+/// @brief Set the world rectangle mapped onto the canvas.
+void CanvasScene::SetView(double x_min,
+                          double x_max,
+                          double y_min,
+                          double y_max) {
+  view_x_min_ = x_min;
+  view_x_max_ = x_max;
+  view_y_min_ = y_min;
+  view_y_max_ = y_max;
+}
+
+/// @brief Move the view.
+/// @param dx the horizontal move, in world units.
+/// @param dy the vertical move, in world units.
+void CanvasScene::Pan(double dx, double dy) {
+  view_x_min_ += dx;
+  view_x_max_ += dx;
+  view_y_min_ += dy;
+  view_y_max_ += dy;
+}
+
+/// @brief Scale the view around a point.
+/// @param factor the zoom factor. Values above 1 zoom in.
+/// @param x the x coordinate of the point staying in place.
+/// @param y the y coordinate of the point staying in place.
+void CanvasScene::Zoom(double factor, double x, double y) {
+  if (factor <= 0.0) {
+    return;
+  }
+  view_x_min_ = x - (x - view_x_min_) / factor;
+  view_x_max_ = x + (view_x_max_ - x) / factor;
+  view_y_min_ = y - (y - view_y_min_) / factor;
+  view_y_max_ = y + (view_y_max_ - y) / factor;
+}
+
+// The bucket is clamped before its conversion, which is undefined for NaN and
+// out of the range of int. NaN maps to the first bucket.
+int CanvasScene::BucketX(double x) const {
+  const double bucket = std::floor((x - x_min_) / bucket_width_);
+  if (!(bucket > 0.0)) {
+    return 0;
+  }
+  return static_cast<int>(std::min(bucket, buckets_x_ - 1.0));
+}
+
+int CanvasScene::BucketY(double y) const {
+  const double bucket = std::floor((y - y_min_) / bucket_height_);
+  if (!(bucket > 0.0)) {
+    return 0;
+  }
+  return static_cast<int>(std::min(bucket, buckets_y_ - 1.0));
+}
+
+// Sort the primitives into a square grid of buckets covering their bounds,
+// with a few primitives per bucket on average.
+void CanvasScene::BuildIndex() {
+  index_valid_ = true;
+  bucket_items_.clear();
+  large_items_.clear();
+  visited_.assign(primitives_.size(), 0);
+  stamp_ = 0;
+  if (primitives_.empty()) {
+    buckets_x_ = 0;
+    buckets_y_ = 0;
+    bucket_begin_.assign(1, 0);
+    return;
+  }
+
+  double x_max = primitives_[0].x1;
+  double y_max = primitives_[0].y1;
+  x_min_ = x_max;
+  y_min_ = y_max;
+  for (const Primitive& p : primitives_) {
+    x_min_ = std::min({x_min_, p.x1, p.x2});
+    x_max = std::max({x_max, p.x1, p.x2});
+    y_min_ = std::min({y_min_, p.y1, p.y2});
+    y_max = std::max({y_max, p.y1, p.y2});
+  }
+
+  const double side = std::sqrt(double(primitives_.size()) / 4.0);
+  buckets_x_ = static_cast<int>(std::clamp(side, 1.0, 1024.0));
+  buckets_y_ = buckets_x_;
+  bucket_width_ = (x_max - x_min_) / buckets_x_;
+  bucket_height_ = (y_max - y_min_) / buckets_y_;
+  if (bucket_width_ <= 0.0) {
+    bucket_width_ = 1.0;
+  }
+  if (bucket_height_ <= 0.0) {
+    bucket_height_ = 1.0;
+  }
+
+  // Count the primitives per bucket, then place them.
+  const size_t buckets = size_t(buckets_x_) * size_t(buckets_y_);
+  bucket_begin_.assign(buckets + 1, 0);
+  auto for_each_bucket = [&](const Primitive& p, auto fn) {
+    const int x0 = BucketX(std::min(p.x1, p.x2));
+    const int x1 = BucketX(std::max(p.x1, p.x2));
+    const int y0 = BucketY(std::min(p.y1, p.y2));
+    const int y1 = BucketY(std::max(p.y1, p.y2));
+    if ((x1 - x0 + 1) * (y1 - y0 + 1) > kMaxBucketsPerPrimitive) {
+      return false;
+    }
+    for (int y = y0; y <= y1; ++y) {
+      for (int x = x0; x <= x1; ++x) {
+        fn(size_t(y) * size_t(buckets_x_) + size_t(x));
+      }
+    }
+    return true;
+  };
+
+  for (const Primitive& p : primitives_) {
+    for_each_bucket(p, [&](size_t bucket) { ++bucket_begin_[bucket + 1]; });
+  }
+  for (size_t i = 0; i < buckets; ++i) {
+    bucket_begin_[i + 1] += bucket_begin_[i];
+  }
+  bucket_items_.resize(bucket_begin_[buckets]);
+  std::vector<uint32_t> cursor(bucket_begin_.begin(), bucket_begin_.end() - 1);
+  for (uint32_t i = 0; i < primitives_.size(); ++i) {
+    const bool indexed = for_each_bucket(primitives_[i], [&](size_t bucket) {
+      bucket_items_[cursor[bucket]++] = i;
+    });
+    if (!indexed) {
+      large_items_.push_back(i);
+    }
+  }
+}
+
+/// @brief Draw the primitives in view onto |canvas|. The view is stretched
+/// over the whole canvas.
+/// @param canvas the canvas to draw onto.
+/// @return the number of primitives visited.
+size_t CanvasScene::Draw(Canvas& canvas) {
+  if (!std::isfinite(view_x_min_) || !std::isfinite(view_x_max_) ||
+      !std::isfinite(view_y_min_) || !std::isfinite(view_y_max_) ||
+      view_x_max_ <= view_x_min_ || view_y_max_ <= view_y_min_ ||
+      canvas.width() <= 0 || canvas.height() <= 0) {
+    return 0;
+  }
+  if (!index_valid_) {
+    BuildIndex();
+  }
+  if (++stamp_ == 0) {
+    std::fill(visited_.begin(), visited_.end(), 0);
+    stamp_ = 1;
+  }
+
+  const ClipRect view = {view_x_min_, view_x_max_, view_y_min_, view_y_max_};
+  const double scale_x = (canvas.width() - 1) / (view_x_max_ - view_x_min_);
+  const double scale_y = (canvas.height() - 1) / (view_y_max_ - view_y_min_);
+  auto to_canvas = [&](double x, double y) {
+    return Canvas::Point{
+        static_cast<int>(std::lround((x - view_x_min_) * scale_x)),
+        static_cast<int>(std::lround((view_y_max_ - y) * scale_y)),
+    };
+  };
+
+  // Consecutive primitives of the same color are drawn in a single call.
+  std::vector<Canvas::Point> points;
+  std::vector<Canvas::Point> segments;
+  Color color;
+  auto flush = [&] {
+    if (!points.empty()) {
+      canvas.DrawPoints(points, color);
+      points.clear();
+    }
+    if (!segments.empty()) {
+      canvas.DrawSegments(segments, color);
+      segments.clear();
+    }
+  };
+
+  size_t visited = 0;
+  auto visit = [&](uint32_t index) {
+    if (visited_[index] == stamp_) {
+      return;
+    }
+    visited_[index] = stamp_;
+    ++visited;
+
+    Primitive p = primitives_[index];
+    if (!ClipSegment(p.x1, p.y1, p.x2, p.y2, view)) {
+      return;
+    }
+    if (p.color != color) {
+      flush();
+      color = p.color;
+    }
+    if (p.x1 == p.x2 && p.y1 == p.y2) {
+      points.push_back(to_canvas(p.x1, p.y1));
+    } else {
+      segments.push_back(to_canvas(p.x1, p.y1));
+      segments.push_back(to_canvas(p.x2, p.y2));
+    }
+  };
+
+  if (buckets_x_ > 0) {
+    const int x0 = BucketX(view_x_min_);
+    const int x1 = BucketX(view_x_max_);
+    const int y0 = BucketY(view_y_min_);
+    const int y1 = BucketY(view_y_max_);
+    for (int y = y0; y <= y1; ++y) {
+      for (int x = x0; x <= x1; ++x) {
+        const size_t bucket = size_t(y) * size_t(buckets_x_) + size_t(x);
+        for (uint32_t i = bucket_begin_[bucket]; i < bucket_begin_[bucket + 1];
+             ++i) {
+          visit(bucket_items_[i]);
+        }
+      }
+    }
+  }
+  for (uint32_t index : large_items_) {
+    visit(index);
+  }
+  flush();
+  return visited;
+}
+
+}  // namespace ftxui
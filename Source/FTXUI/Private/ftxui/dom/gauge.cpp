@@ -118,9 +118,7 @@ class Gauge : public Node {
     }
 
     if (invert) {
-      for (int x = box_.x_min; x <= box_.x_max; x++) {
-        screen.PixelAt(x, y).inverted ^= true;
-      }
+      screen.ToggleStyle(Box{box_.x_min, box_.x_max, y, y}, Pixel::Inverted);
     }
   }
 
@@ -148,9 +146,7 @@ class Gauge : public Node {
     }
 
     if (invert) {
-      for (int y = box_.y_min; y <= box_.y_max; y++) {
-        screen.PixelAt(x, y).inverted ^= true;
-      }
+      screen.ToggleStyle(Box{x, x, box_.y_min, box_.y_max}, Pixel::Inverted);
     }
   }
 
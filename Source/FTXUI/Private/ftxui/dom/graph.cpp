@@ -2,7 +2,7 @@
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
 #include <functional>  // for function
-#include <memory>      // for allocator, make_shared
+#include <memory>      // for allocator, make_shared, shared_ptr
 #include <string>      // for string
 #include <utility>     // for move
 #include <vector>      // for vector
@@ -10,6 +10,7 @@
 #include "ftxui/dom/elements.hpp"     // for GraphFunction, Element, graph
 #include "ftxui/dom/node.hpp"         // for Node
 #include "ftxui/dom/requirement.hpp"  // for Requirement
+#include "ftxui/dom/time_series.hpp"  // for TimeSeries
 #include "ftxui/screen/box.hpp"       // for Box
 #include "ftxui/screen/screen.hpp"    // for Screen
 
@@ -72,4 +73,12 @@ Element graph(GraphFunction graph_function) {
   return std::make_shared<Graph>(std::move(graph_function));
 }
 
+/// @brief Draw the most recent samples of a TimeSeries.
+/// @param series the samples. Producer threads can keep pushing into it.
+Element graph(std::shared_ptr<TimeSeries> series) {
+  return graph([series = std::move(series)](int width, int height) {
+    return series->Sample(width, height);
+  });
+}
+
 }  // namespace ftxui
@@ -34,16 +34,21 @@ int Integrate(std::vector<int>& elements) {
 
 class GridBox : public Node {
  public:
-  explicit GridBox(std::vector<Elements> lines) : lines_(std::move(lines)) {
-    y_size = lines_.size();
-    for (const auto& line : lines_) {
+  explicit GridBox(std::vector<Elements> lines) {
+    y_size = static_cast<int>(lines.size());
+    for (const auto& line : lines) {
       x_size = std::max(x_size, int(line.size()));
     }
 
-    // Fill in empty cells, in case the user did not used the API correctly:
-    for (auto& line : lines_) {
-      while (line.size() < size_t(x_size)) {
-        line.push_back(filler());
+    // Store the cells in a flat row-major array. Fill in empty cells, in case
+    // the user did not used the API correctly:
+    children_.reserve(size_t(x_size) * size_t(y_size));
+    for (auto& line : lines) {
+      for (auto& cell : line) {
+        children_.push_back(std::move(cell));
+      }
+      for (size_t x = line.size(); x < size_t(x_size); ++x) {
+        children_.push_back(filler());
       }
     }
   }
@@ -56,101 +61,105 @@ class GridBox : public Node {
     requirement_.flex_shrink_x = 0;
     requirement_.flex_shrink_y = 0;
 
-    for (auto& line : lines_) {
-      for (auto& cell : line) {
-        cell->ComputeRequirement();
-      }
-    }
-
-    // Compute the size of each columns/row.
-    std::vector<int> size_x(x_size, 0);
-    std::vector<int> size_y(y_size, 0);
-    for (int x = 0; x < x_size; ++x) {
-      for (int y = 0; y < y_size; ++y) {
-        size_x[x] = std::max(size_x[x], lines_[y][x]->requirement().min_x);
-        size_y[y] = std::max(size_y[y], lines_[y][x]->requirement().min_y);
-      }
-    }
-
-    requirement_.min_x = Integrate(size_x);
-    requirement_.min_y = Integrate(size_y);
-
-    // Forward the selected/focused child state:
-    requirement_.selection = Requirement::NORMAL;
-    for (int x = 0; x < x_size; ++x) {
-      for (int y = 0; y < y_size; ++y) {
-        if (requirement_.selection >= lines_[y][x]->requirement().selection) {
-          continue;
-        }
-        requirement_.selection = lines_[y][x]->requirement().selection;
-        requirement_.selected_box = lines_[y][x]->requirement().selected_box;
-        requirement_.selected_box.x_min += size_x[x];
-        requirement_.selected_box.x_max += size_x[x];
-        requirement_.selected_box.y_min += size_y[y];
-        requirement_.selected_box.y_max += size_y[y];
-      }
-    }
-  }
-
-  void SetBox(Box box) override {
-    Node::SetBox(box);
-
     box_helper::Element init;
     init.min_size = 0;
     init.flex_grow = 1024;    // NOLINT
     init.flex_shrink = 1024;  // NOLINT
-    std::vector<box_helper::Element> elements_x(x_size, init);
-    std::vector<box_helper::Element> elements_y(y_size, init);
-
+    elements_x_.assign(x_size, init);
+    elements_y_.assign(y_size, init);
+    offset_x_.resize(x_size);
+    offset_y_.resize(y_size);
+
+    // Single row-major pass: compute the requirement of every cell, and
+    // accumulate the size and flex of every column and row at once.
+    int selected = -1;
+    int selected_x = 0;
+    requirement_.selection = Requirement::NORMAL;
+    auto cell = children_.begin();
     for (int y = 0; y < y_size; ++y) {
-      for (int x = 0; x < x_size; ++x) {
-        const auto& cell = lines_[y][x];
-        const auto& requirement = cell->requirement();
-        auto& e_x = elements_x[x];
-        auto& e_y = elements_y[y];
+      auto& e_y = elements_y_[y];
+      for (int x = 0; x < x_size; ++x, ++cell) {
+        (*cell)->ComputeRequirement();
+        const auto& requirement = (*cell)->requirement();
+        auto& e_x = elements_x_[x];
         e_x.min_size = std::max(e_x.min_size, requirement.min_x);
         e_y.min_size = std::max(e_y.min_size, requirement.min_y);
         e_x.flex_grow = std::min(e_x.flex_grow, requirement.flex_grow_x);
         e_y.flex_grow = std::min(e_y.flex_grow, requirement.flex_grow_y);
         e_x.flex_shrink = std::min(e_x.flex_shrink, requirement.flex_shrink_x);
         e_y.flex_shrink = std::min(e_y.flex_shrink, requirement.flex_shrink_y);
+
+        // Forward the selected/focused child state. On ties, the left-most
+        // then top-most cell wins.
+        if (requirement_.selection < requirement.selection ||
+            (selected != -1 &&
+             requirement_.selection == requirement.selection &&
+             x < selected_x)) {
+          requirement_.selection = requirement.selection;
+          selected = y * x_size + x;
+          selected_x = x;
+        }
       }
     }
 
+    for (int x = 0; x < x_size; ++x) {
+      offset_x_[x] = elements_x_[x].min_size;
+    }
+    for (int y = 0; y < y_size; ++y) {
+      offset_y_[y] = elements_y_[y].min_size;
+    }
+    requirement_.min_x = Integrate(offset_x_);
+    requirement_.min_y = Integrate(offset_y_);
+
+    if (selected != -1) {
+      const int x = selected % x_size;
+      const int y = selected / x_size;
+      requirement_.selected_box =
+          children_[selected]->requirement().selected_box;
+      requirement_.selected_box.x_min += offset_x_[x];
+      requirement_.selected_box.x_max += offset_x_[x];
+      requirement_.selected_box.y_min += offset_y_[y];
+      requirement_.selected_box.y_max += offset_y_[y];
+    }
+  }
+
+  void SetBox(Box box) override {
+    Node::SetBox(box);
+
+    // |elements_x_| and |elements_y_| were filled by ComputeRequirement().
     const int target_size_x = box.x_max - box.x_min + 1;
     const int target_size_y = box.y_max - box.y_min + 1;
-    box_helper::Compute(&elements_x, target_size_x);
-    box_helper::Compute(&elements_y, target_size_y);
+    box_helper::Compute(&elements_x_, target_size_x);
+    box_helper::Compute(&elements_y_, target_size_y);
 
+    auto cell = children_.begin();
     Box box_y = box;
     int y = box_y.y_min;
     for (int iy = 0; iy < y_size; ++iy) {
       box_y.y_min = y;
-      y += elements_y[iy].size;
+      y += elements_y_[iy].size;
       box_y.y_max = y - 1;
 
       Box box_x = box_y;
       int x = box_x.x_min;
-      for (int ix = 0; ix < x_size; ++ix) {
+      for (int ix = 0; ix < x_size; ++ix, ++cell) {
         box_x.x_min = x;
-        x += elements_x[ix].size;
+        x += elements_x_[ix].size;
         box_x.x_max = x - 1;
-        lines_[iy][ix]->SetBox(box_x);
-      }
-    }
-  }
-
-  void Render(Screen& screen) override {
-    for (auto& line : lines_) {
-      for (auto& cell : line) {
-        cell->Render(screen);
+        (*cell)->SetBox(box_x);
       }
     }
   }
 
   int x_size = 0;
   int y_size = 0;
-  std::vector<Elements> lines_;
+
+  // Scratch buffers, reused across frames to avoid reallocating them on every
+  // layout pass.
+  std::vector<box_helper::Element> elements_x_;
+  std::vector<box_helper::Element> elements_y_;
+  std::vector<int> offset_x_;
+  std::vector<int> offset_y_;
 };
 }  // namespace
    //
@@ -0,0 +1,153 @@
+// Copyright 2020 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <algorithm>   // for max, min
+#include <array>       // for array
+#include <cmath>       // for isfinite
+#include <cstddef>     // for size_t
+#include <functional>  // for function
+#include <limits>      // for numeric_limits
+#include <memory>      // for make_shared
+#include <span>        // for span
+
+#include "ftxui/dom/elements.hpp"     // for Element, heatmap
+#include "ftxui/dom/node.hpp"         // for Node
+#include "ftxui/dom/requirement.hpp"  // for Requirement
+#include "ftxui/screen/box.hpp"       // for Box
+#include "ftxui/screen/color.hpp"     // for Color
+#include "ftxui/screen/screen.hpp"    // for Pixel, Screen
+
+namespace ftxui {
+
+namespace {
+
+class Heatmap : public Node {
+ public:
+  Heatmap(std::span<const float> values,
+          int width,
+          int height,
+          const std::function<Color(float)>& colormap)
+      : values_(values),
+        width_(std::max(0, width)),
+        height_(std::max(0, height)) {
+    // Only complete rows are displayed.
+    if (width_ == 0 || int(values_.size()) / width_ < height_) {
+      height_ = width_ ? int(values_.size()) / width_ : 0;
+    }
+    for (size_t i = 0; i < lut_.size(); ++i) {
+      lut_[i] = colormap(float(i) / float(lut_.size() - 1));
+    }
+    // The non finite values are ignored by the range.
+    float min = std::numeric_limits<float>::infinity();
+    float max = -std::numeric_limits<float>::infinity();
+    for (const float value : values_.first(size_t(width_) * size_t(height_))) {
+      if (std::isfinite(value)) {
+        min = std::min(min, value);
+        max = std::max(max, value);
+      }
+    }
+    if (min <= max) {
+      min_ = min;
+      // In double, as the extent of two finite floats may overflow.
+      const double extent = double(max) - double(min);
+      scale_ = extent > 0. ? float(double(lut_.size() - 1) / extent) : 0.F;
+    }
+  }
+
+  void ComputeRequirement() override {
+    requirement_.min_x = width_;
+    requirement_.min_y = (height_ + 1) / 2;
+  }
+
+  void Render(Screen& screen) override {
+    Box area = box_;
+    area.x_max = std::min(area.x_max, box_.x_min + width_ - 1);
+    area.y_max = std::min(area.y_max, box_.y_min + (height_ + 1) / 2 - 1);
+    area = Box::Intersection(area, screen.stencil);
+    for (int y = area.y_min; y <= area.y_max; ++y) {
+      // Every cell displays two samples: the upper one as the foreground of
+      // the upper half block, the lower one as its background.
+      const int row = 2 * (y - box_.y_min);
+      const float* upper = values_.data() + size_t(row) * size_t(width_) +
+                           size_t(area.x_min - box_.x_min);
+      const float* lower = row + 1 < height_ ? upper + width_ : nullptr;
+      screen.ForEachRow({area.x_min, area.x_max, y, y},
+                        [&](Pixel* begin, Pixel* end) {
+                          for (Pixel* pixel = begin; pixel != end; ++pixel) {
+                            pixel->character = "▀";
+                            pixel->foreground_color = Lookup(*upper++);
+                            if (lower) {
+                              pixel->background_color = Lookup(*lower++);
+                            }
+                          }
+                        });
+    }
+  }
+
+ private:
+  // The index is clamped before its conversion, which is undefined out of
+  // the range of int. NaN and -inf map to the first color, +inf to the last.
+  const Color& Lookup(float value) const {
+    const float index = (value - min_) * scale_;
+    if (!(index > 0.F)) {
+      return lut_[0];
+    }
+    return lut_[size_t(std::min(index, float(lut_.size() - 1)))];
+  }
+
+  std::span<const float> values_;
+  int width_;
+  int height_;
+  std::array<Color, 256> lut_;  // NOLINT
+  float min_ = 0.F;
+  float scale_ = 0.F;
+};
+
+}  // namespace
+
+/// @brief Display a matrix of values as colors. Every character displays two
+/// rows, using the upper half block with distinct foreground and background
+/// colors.
+/// @param values the matrix, row by row. Its size is |width| x |height|. It
+/// is not copied, and must outlive the element.
+/// @param width the number of columns.
+/// @param height the number of rows.
+/// @param colormap maps a value, normalized into [0, 1], to a color. It is
+/// sampled into a table of 256 colors.
+/// @ingroup dom
+///
+/// ### Example
+///
+/// ```cpp
+/// std::vector<float> latency(hosts * minutes);
+/// Element document = heatmap(latency, minutes, hosts, [](float t) {
+///   return Color::Interpolate(t, Color::Blue, Color::Red);
+/// });
+/// ```
+Element heatmap(std::span<const float> values,
+                int width,
+                int height,
+                std::function<Color(float)> colormap) {
+  return std::make_shared<Heatmap>(values, width, height, colormap);
+}
+
+/// @brief Display a matrix of values as colors, interpolated in between two
+/// colors.
+/// @param values the matrix, row by row. Its size is |width| x |height|. It
+/// is not copied, and must outlive the element.
+/// @param width the number of columns.
+/// @param height the number of rows.
+/// @param low the color of the smallest value.
+/// @param high the color of the biggest value.
+/// @ingroup dom
+Element heatmap(std::span<const float> values,
+                int width,
+                int height,
+                Color low,
+                Color high) {
+  return heatmap(values, width, height, [low, high](float t) {
+    return Color::Interpolate(t, low, high);
+  });
+}
+
+}  // namespace ftxui
@@ -0,0 +1,164 @@
+// Copyright 2020 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <algorithm>  // for max, min, fill
+#include <cstddef>    // for size_t
+#include <cstdint>    // for int64_t, uint8_t, uint32_t, uint64_t
+#include <memory>     // for make_shared
+#include <span>       // for span
+#include <vector>     // for vector
+
+#include "ftxui/dom/elements.hpp"     // for Element, image
+#include "ftxui/dom/node.hpp"         // for Node
+#include "ftxui/dom/requirement.hpp"  // for Requirement
+#include "ftxui/screen/box.hpp"       // for Box
+#include "ftxui/screen/color.hpp"     // for Color
+#include "ftxui/screen/screen.hpp"    // for Pixel, Screen
+
+namespace ftxui {
+
+namespace {
+
+// The source interval [begin, end) averaged into each of |target| bins. When
+// upscaling, a bin takes the nearest source sample.
+struct SourceSpan {
+  int begin;
+  int end;
+};
+std::vector<SourceSpan> ComputeSpans(int source, int target) {
+  std::vector<SourceSpan> spans(static_cast<size_t>(target));
+  for (int i = 0; i < target; ++i) {
+    const int begin = int(int64_t(i) * source / target);
+    const int end = int(int64_t(i + 1) * source / target);
+    spans[size_t(i)] = {begin, std::max(end, begin + 1)};
+  }
+  return spans;
+}
+
+class Image : public Node {
+ public:
+  Image(std::span<const uint8_t> rgba, int width, int height)
+      : rgba_(rgba), width_(width), height_(height) {
+    if (width_ <= 0 || height_ <= 0 ||
+        rgba_.size() < size_t(width_) * size_t(height_) * 4) {
+      width_ = 0;
+      height_ = 0;
+    }
+  }
+
+  void ComputeRequirement() override {
+    requirement_.flex_grow_x = 1;
+    requirement_.flex_grow_y = 1;
+    requirement_.flex_shrink_x = 1;
+    requirement_.flex_shrink_y = 1;
+    requirement_.min_x = 1;
+    requirement_.min_y = 1;
+  }
+
+  void Render(Screen& screen) override {
+    const Box area = Box::Intersection(box_, screen.stencil);
+    if (width_ == 0 || area.IsEmpty()) {
+      return;
+    }
+
+    // The image is stretched over the box, each character holding two rows
+    // of the downscaled image. Only the visible part is computed.
+    const int target_width = box_.x_max - box_.x_min + 1;
+    const int target_height = 2 * (box_.y_max - box_.y_min + 1);
+    const std::vector<SourceSpan> columns = ComputeSpans(width_, target_width);
+    const std::vector<SourceSpan> rows = ComputeSpans(height_, target_height);
+
+    const int visible = area.x_max - area.x_min + 1;
+    std::vector<uint64_t> upper(size_t(visible) * 4);
+    std::vector<uint64_t> lower(size_t(visible) * 4);
+    for (int y = area.y_min; y <= area.y_max; ++y) {
+      const int row = 2 * (y - box_.y_min);
+      Accumulate(rows[size_t(row)], columns, area.x_min - box_.x_min, upper);
+      Accumulate(rows[size_t(row + 1)], columns, area.x_min - box_.x_min,
+                 lower);
+      screen.ForEachRow({area.x_min, area.x_max, y, y},
+                        [&](Pixel* begin, Pixel* end) {
+                          const uint64_t* u = upper.data();
+                          const uint64_t* l = lower.data();
+                          for (Pixel* pixel = begin; pixel != end; ++pixel) {
+                            pixel->character = "▀";
+                            SetColor(u, pixel->foreground_color);
+                            SetColor(l, pixel->background_color);
+                            u += 4;
+                            l += 4;
+                          }
+                        });
+    }
+  }
+
+ private:
+  // Sum the samples of every visible column over the source rows of |row|.
+  // The red, green and blue channels are weighted by alpha. The fourth channel
+  // receives the sum of alpha. The inner loop runs over contiguous bytes with
+  // 32 bits accumulators, which compilers vectorize.
+  void Accumulate(const SourceSpan& row,
+                  const std::vector<SourceSpan>& columns,
+                  int first_column,
+                  std::vector<uint64_t>& sums) const {
+    std::fill(sums.begin(), sums.end(), 0);
+    const size_t count = sums.size() / 4;
+    for (int y = row.begin; y < row.end; ++y) {
+      const uint8_t* line = rgba_.data() + size_t(y) * size_t(width_) * 4;
+      for (size_t i = 0; i < count; ++i) {
+        const SourceSpan& column = columns[size_t(first_column) + i];
+        uint32_t r = 0;
+        uint32_t g = 0;
+        uint32_t b = 0;
+        uint32_t a = 0;
+        for (int x = column.begin; x < column.end; ++x) {
+          const uint8_t* p = line + size_t(x) * 4;
+          r += uint32_t(p[0]) * p[3];
+          g += uint32_t(p[1]) * p[3];
+          b += uint32_t(p[2]) * p[3];
+          a += p[3];
+        }
+        sums[4 * i + 0] += r;
+        sums[4 * i + 1] += g;
+        sums[4 * i + 2] += b;
+        sums[4 * i + 3] += a;
+      }
+    }
+  }
+
+  // Fully transparent areas keep the existing color.
+  static void SetColor(const uint64_t* sum, Color& color) {
+    if (sum[3] == 0) {
+      return;
+    }
+    color = Color::RGB(uint8_t(sum[0] / sum[3]),  //
+                       uint8_t(sum[1] / sum[3]),  //
+                       uint8_t(sum[2] / sum[3]));
+  }
+
+  std::span<const uint8_t> rgba_;
+  int width_;
+  int height_;
+};
+
+}  // namespace
+
+/// @brief Display an RGBA image. It is stretched over the space available,
+/// using two rows of pixels per character. Every pixel of the image covered by
+/// a character's half is averaged into its color.
+/// @param rgba the pixels, row by row, 4 bytes each: red, green, blue, alpha.
+/// They are not copied, and must outlive the element.
+/// @param width the width of the image, in pixels.
+/// @param height the height of the image, in pixels.
+/// @ingroup dom
+///
+/// ### Example
+///
+/// ```cpp
+/// Element preview = image(frame.pixels, frame.width, frame.height)
+///                 | size(WIDTH, EQUAL, 160) | size(HEIGHT, EQUAL, 48);
+/// ```
+Element image(std::span<const uint8_t> rgba, int width, int height) {
+  return std::make_shared<Image>(rgba, width, height);
+}
+
+}  // namespace ftxui
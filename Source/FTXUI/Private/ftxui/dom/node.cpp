@@ -28,13 +28,23 @@ void Node::SetBox(Box box) {
 }
 
 /// @brief Display an element on a ftxui::Screen.
+/// Children lying entirely outside of the screen's stencil are skipped.
 /// @ingroup dom
 void Node::Render(Screen& screen) {
   for (auto& child : children_) {
-    child->Render(screen);
+    if (child->IsVisible(screen)) {
+      child->Render(screen);
+    }
   }
 }
 
+/// @brief Whether the box assigned to this element intersects the screen's
+/// stencil.
+/// @ingroup dom
+bool Node::IsVisible(const Screen& screen) const {
+  return !Box::Intersection(box_, screen.stencil).IsEmpty();
+}
+
 void Node::Check(Status* status) {
   for (auto& child : children_) {
     child->Check(status);
@@ -26,13 +26,15 @@ class Reflect : public Node {
   }
 
   void SetBox(Box box) final {
-    reflected_box_ = box;
+    // The reflected box is only known once rendered. Until then, or if the
+    // parent culls this element, it stays empty.
+    reflected_box_ = Box{0, -1, 0, -1};
     Node::SetBox(box);
     children_[0]->SetBox(box);
   }
 
   void Render(Screen& screen) final {
-    reflected_box_ = Box::Intersection(screen.stencil, reflected_box_);
+    reflected_box_ = Box::Intersection(screen.stencil, box_);
     return Node::Render(screen);
   }
 
@@ -0,0 +1,91 @@
+// Copyright 2023 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <cstdint>  // for uint8_t
+#include <memory>   // for make_shared
+#include <utility>  // for move
+
+#include "ftxui/dom/node.hpp"        // for Node
+#include "ftxui/dom/style_node.hpp"  // for StyleNode
+#include "ftxui/screen/screen.hpp"   // for Pixel, Screen
+
+namespace ftxui {
+
+StyleNode::StyleNode(Element child, Style style)
+    : NodeDecorator(std::move(child)), style_(std::move(style)) {}
+
+// static
+Element StyleNode::Apply(Element child, Style style) {
+  StyleNode* node = child ? child->AsStyleNode() : nullptr;
+  if (!node) {
+    return std::make_shared<StyleNode>(std::move(child), std::move(style));
+  }
+
+  // Nobody else can observe |child|. It can be modified in place.
+  if (child.use_count() == 1) {
+    node->Merge(std::move(style));
+    return child;
+  }
+
+  auto fused = std::make_shared<StyleNode>(node->children_[0], node->style_);
+  fused->Merge(std::move(style));
+  return fused;
+}
+
+void StyleNode::Merge(Style outer) {
+  style_.set |= outer.set;
+  style_.set_after |= outer.set_after;
+  style_.toggle ^= outer.toggle;
+  if (!style_.foreground_color) {
+    style_.foreground_color = outer.foreground_color;
+  }
+  if (!style_.background_color) {
+    style_.background_color = outer.background_color;
+  }
+  if (!style_.hyperlink) {
+    style_.hyperlink = std::move(outer.hyperlink);
+  }
+}
+
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+void StyleNode::Render(Screen& screen) {
+  const uint8_t set = style_.set;
+  const bool has_foreground = style_.foreground_color.has_value();
+  const bool has_background = style_.background_color.has_value();
+  const bool has_hyperlink = style_.hyperlink.has_value();
+  const Color foreground = style_.foreground_color.value_or(Color());
+  const Color background = style_.background_color.value_or(Color());
+  const uint8_t hyperlink =
+      has_hyperlink ? screen.RegisterHyperlink(*style_.hyperlink) : 0;
+
+  if (set || has_foreground || has_background || has_hyperlink) {
+    screen.ForEachRow(box_, [&](Pixel* begin, Pixel* end) {
+      for (Pixel* pixel = begin; pixel != end; ++pixel) {
+        // clang-format off
+        if (set & Pixel::Blink)            { pixel->blink = true; }
+        if (set & Pixel::Bold)             { pixel->bold = true; }
+        if (set & Pixel::Dim)              { pixel->dim = true; }
+        if (set & Pixel::Inverted)         { pixel->inverted = true; }
+        if (set & Pixel::Underlined)       { pixel->underlined = true; }
+        if (set & Pixel::UnderlinedDouble) { pixel->underlined_double = true; }
+        if (set & Pixel::Strikethrough)    { pixel->strikethrough = true; }
+        if (set & Pixel::Automerge)        { pixel->automerge = true; }
+        if (has_foreground) { pixel->foreground_color = foreground; }
+        if (has_background) { pixel->background_color = background; }
+        if (has_hyperlink)  { pixel->hyperlink = hyperlink; }
+        // clang-format on
+      }
+    });
+  }
+
+  NodeDecorator::Render(screen);
+
+  if (style_.set_after) {
+    screen.FillStyle(box_, style_.set_after, style_.set_after);
+  }
+  if (style_.toggle) {
+    screen.ToggleStyle(box_, style_.toggle);
+  }
+}
+
+}  // namespace ftxui
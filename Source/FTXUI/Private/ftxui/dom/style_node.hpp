@@ -0,0 +1,53 @@
+// Copyright 2023 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#ifndef FTXUI_DOM_STYLE_NODE_HPP
+#define FTXUI_DOM_STYLE_NODE_HPP
+
+#include <cstdint>   // for uint8_t
+#include <optional>  // for optional
+#include <string>    // for string
+
+#include "ftxui/dom/elements.hpp"        // for Element
+#include "ftxui/dom/node_decorator.hpp"  // for NodeDecorator
+#include "ftxui/screen/color.hpp"        // for Color
+
+namespace ftxui {
+class Screen;
+
+// A decorator applying pure style attributes to its child. Decorating a
+// StyleNode with another style fuses both into a single node, so that a chain
+// like `text(x) | bold | color(c) | inverted` paints its box in one pass.
+class FTXUI_API StyleNode : public NodeDecorator {
+ public:
+  struct Style {
+    // Pixel::Style flags set before drawing the child.
+    uint8_t set = 0;
+    // Pixel::Style flags set after drawing the child.
+    uint8_t set_after = 0;
+    // Pixel::Style flags flipped after drawing the child.
+    uint8_t toggle = 0;
+    std::optional<Color> foreground_color;
+    std::optional<Color> background_color;
+    std::optional<std::string> hyperlink;
+  };
+
+  StyleNode(Element child, Style style);
+
+  // Apply |style| to |child|. When |child| is already a StyleNode, the styles
+  // are merged instead of adding a new node. Like with nested decorators, the
+  // colors and the hyperlink of the innermost one win.
+  static Element Apply(Element child, Style style);
+
+  void Render(Screen& screen) override;
+
+ private:
+  StyleNode* AsStyleNode() override { return this; }
+  void Merge(Style outer);
+
+  Style style_;
+};
+
+}  // namespace ftxui
+
+#endif  // FTXUI_DOM_STYLE_NODE_HPP
@@ -0,0 +1,242 @@
+// Copyright 2020 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <algorithm>  // for lower_bound, max, min
+#include <cstddef>    // for size_t
+#include <memory>     // for make_shared
+#include <string>     // for string
+#include <utility>    // for move
+#include <vector>     // for vector
+
+#include "ftxui/dom/elements.hpp"     // for Element, StyleRun, styledText
+#include "ftxui/dom/node.hpp"         // for Node
+#include "ftxui/dom/requirement.hpp"  // for Requirement
+#include "ftxui/screen/box.hpp"       // for Box
+#include "ftxui/screen/screen.hpp"    // for Pixel, Screen
+#include "ftxui/screen/string.hpp"    // for Utf8ToGlyphs
+
+namespace ftxui {
+
+namespace {
+
+class StyledText : public Node {
+ public:
+  StyledText(const std::string& text, std::vector<StyleRun> runs, bool wrap)
+      : glyphs_(Utf8ToGlyphs(text)), runs_(std::move(runs)), wrap_(wrap) {
+    // Assign every glyph the last run covering its first byte.
+    std::vector<size_t> offsets;
+    offsets.reserve(glyphs_.size());
+    size_t offset = 0;
+    for (const auto& glyph : glyphs_) {
+      offsets.push_back(offset);
+      offset += glyph.size();
+    }
+    glyph_run_.assign(glyphs_.size(), -1);
+    for (size_t r = 0; r < runs_.size(); ++r) {
+      auto it =
+          std::lower_bound(offsets.begin(), offsets.end(), runs_[r].begin);
+      for (; it != offsets.end() && *it < runs_[r].end; ++it) {
+        glyph_run_[size_t(it - offsets.begin())] = int(r);
+      }
+    }
+    // The padding after a fullwidth glyph shares its style.
+    for (size_t i = 1; i < glyphs_.size(); ++i) {
+      if (glyphs_[i].empty()) {
+        glyph_run_[i] = glyph_run_[i - 1];
+      }
+    }
+
+    if (!wrap_) {
+      int width = 0;
+      for (const auto& glyph : glyphs_) {
+        width += (glyph != "\n");
+      }
+      lines_.push_back({0, glyphs_.size(), width});
+    }
+  }
+
+  void ComputeRequirement() override {
+    if (wrap_) {
+      Layout(asked_);
+    }
+    requirement_.min_x = 0;
+    for (const Line& line : lines_) {
+      requirement_.min_x = std::max(requirement_.min_x, line.width);
+    }
+    requirement_.min_y = int(lines_.size());
+  }
+
+  void SetBox(Box box) override {
+    Node::SetBox(box);
+    if (!wrap_) {
+      return;
+    }
+    const int asked_previous = asked_;
+    asked_ = std::min(asked_, box.x_max - box.x_min + 1);
+    need_iteration_ = (asked_ != asked_previous);
+    Layout(box.x_max - box.x_min + 1);
+  }
+
+  void Check(Status* status) override {
+    if (status->iteration == 0) {
+      asked_ = 6000;  // NOLINT
+      need_iteration_ = true;
+    }
+    status->need_iteration |= need_iteration_;
+  }
+
+  void Render(Screen& screen) override {
+    const int y_max =
+        std::min(box_.y_max, box_.y_min + int(lines_.size()) - 1);
+    for (int y = std::max(box_.y_min, screen.stencil.y_min); y <= y_max; ++y) {
+      RenderLine(screen, lines_[size_t(y - box_.y_min)], y);
+    }
+  }
+
+ private:
+  struct Line {
+    size_t begin;  // Index of the first glyph.
+    size_t end;    // Index past the last glyph.
+    int width;
+  };
+
+  // Write the glyphs, then apply the style of every run of the line.
+  void RenderLine(Screen& screen, const Line& line, int y) const {
+    const Box row = {
+        box_.x_min,
+        std::min(box_.x_max, box_.x_min + line.width - 1),
+        y,
+        y,
+    };
+    const int skip = std::max(box_.x_min, screen.stencil.x_min) - box_.x_min;
+    screen.ForEachRow(row, [&](Pixel* begin, Pixel* end) {
+      int column = 0;
+      for (size_t i = line.begin; i < line.end && begin != end; ++i) {
+        if (glyphs_[i] == "\n") {
+          continue;
+        }
+        if (column++ >= skip) {
+          (begin++)->character = glyphs_[i];
+        }
+      }
+    });
+
+    int x = box_.x_min;
+    size_t i = line.begin;
+    while (i < line.end) {
+      const int run = glyph_run_[i];
+      const int x_begin = x;
+      for (; i < line.end && glyph_run_[i] == run; ++i) {
+        x += (glyphs_[i] != "\n");
+      }
+      if (run < 0 || x == x_begin) {
+        continue;
+      }
+      const StyleRun& style = runs_[size_t(run)];
+      const Box segment = {x_begin, std::min(x - 1, row.x_max), y, y};
+      if (style.style) {
+        screen.FillStyle(segment, style.style, style.style);
+      }
+      if (style.foreground_color) {
+        screen.FillColor(segment, *style.foreground_color, false);
+      }
+      if (style.background_color) {
+        screen.FillColor(segment, *style.background_color, true);
+      }
+    }
+  }
+
+  // Break the glyphs into lines no wider than |width|. Lines are broken after
+  // the last space when possible, and on newlines.
+  void Layout(int width) {
+    width = std::max(width, 1);
+    lines_.clear();
+    size_t start = 0;
+    int columns = 0;
+    size_t last_space = std::string::npos;
+    for (size_t i = 0; i < glyphs_.size(); ++i) {
+      const std::string& glyph = glyphs_[i];
+      if (glyph == "\n") {
+        lines_.push_back({start, i, columns});
+        start = i + 1;
+        columns = 0;
+        last_space = std::string::npos;
+        continue;
+      }
+
+      if (columns + 1 > width && columns > 0) {
+        if (glyph == " ") {
+          // The space at the break is dropped.
+          lines_.push_back({start, i, columns});
+          start = i + 1;
+          columns = 0;
+          last_space = std::string::npos;
+          continue;
+        }
+        size_t end = i;
+        size_t next = i;
+        if (last_space != std::string::npos) {
+          end = last_space;
+          next = last_space + 1;
+        } else if (glyph.empty() && i - 1 > start) {
+          // Keep a fullwidth glyph together with its padding.
+          end = i - 1;
+          next = i - 1;
+        }
+        lines_.push_back({start, end, int(end - start)});
+        start = next;
+        columns = int(i - next);
+        last_space = std::string::npos;
+      }
+
+      if (glyph == " " && i > start) {
+        last_space = i;
+      }
+      ++columns;
+    }
+    lines_.push_back({start, glyphs_.size(), columns});
+  }
+
+  std::vector<std::string> glyphs_;
+  std::vector<int> glyph_run_;  // Index into |runs_|, or -1.
+  std::vector<StyleRun> runs_;
+  bool wrap_;
+  std::vector<Line> lines_;
+  int asked_ = 6000;  // NOLINT
+  bool need_iteration_ = false;
+};
+
+}  // namespace
+
+/// @brief Display a piece of UTF8 encoded text, with styled ranges. This is
+/// a single element, replacing an hbox of decorated texts.
+/// @param text the text.
+/// @param runs the styled ranges of |text|, in bytes. When they overlap, the
+/// last one wins.
+/// @ingroup dom
+///
+/// ### Example
+///
+/// ```cpp
+/// StyleRun keyword;
+/// keyword.begin = 0;
+/// keyword.end = 6;
+/// keyword.style = Pixel::Bold;
+/// keyword.foreground_color = Color::Blue;
+/// Element document = styledText("return 0;", {keyword});
+/// ```
+Element styledText(std::string text, std::vector<StyleRun> runs) {
+  return std::make_shared<StyledText>(text, std::move(runs), false);
+}
+
+/// @brief Same as styledText, but wrapped on multiple lines to fit the width
+/// available. Lines are broken on spaces and newlines.
+/// @param text the text.
+/// @param runs the styled ranges of |text|, in bytes. When they overlap, the
+/// last one wins.
+/// @ingroup dom
+Element styledParagraph(std::string text, std::vector<StyleRun> runs) {
+  return std::make_shared<StyledText>(text, std::move(runs), true);
+}
+
+}  // namespace ftxui
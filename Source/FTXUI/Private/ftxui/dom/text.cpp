@@ -1,64 +1,126 @@
 // Copyright 2020 Arthur Sonzogni. All rights reserved.
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
-#include <algorithm>  // for min
-#include <memory>     // for make_shared
-#include <string>     // for string, wstring
-#include <utility>    // for move
-#include <vector>     // for vector
+#include <algorithm>    // for min
+#include <array>        // for array
+#include <cstddef>      // for size_t
+#include <cstdint>      // for uint32_t, uint64_t, uintptr_t
+#include <memory>       // for make_shared, shared_ptr, weak_ptr
+#include <string>       // for string, wstring
+#include <string_view>  // for string_view
+#include <utility>      // for move
+#include <vector>       // for vector
 
 #include "ftxui/dom/deprecated.hpp"   // for text, vtext
-#include "ftxui/dom/elements.hpp"     // for Element, text, vtext
+#include "ftxui/dom/elements.hpp"     // for Element, text, text_view, vtext
 #include "ftxui/dom/node.hpp"         // for Node
 #include "ftxui/dom/requirement.hpp"  // for Requirement
 #include "ftxui/screen/box.hpp"       // for Box
 #include "ftxui/screen/screen.hpp"    // for Pixel, Screen
-#include "ftxui/screen/string.hpp"  // for string_width, Utf8ToGlyphs, to_string
+#include "ftxui/screen/string.hpp"  // for MeasureText, string_width, Utf8ToGlyphs, to_string
+#include "ftxui/screen/string_internal.hpp"  // for EatCodePoint, IsCombining, IsControl, IsFullWidth
 
 namespace ftxui {
 
 namespace {
 using ftxui::Screen;
 
+// The width of the texts referencing memory owned by the caller, keyed on the
+// address and length of the buffer. Shared buffers are also keyed on their
+// owner, so that a new buffer allocated at the same address is measured again.
+struct WidthCacheEntry {
+  const char* data = nullptr;
+  size_t size = 0;
+  std::weak_ptr<const std::string> owner;
+  int width = 0;
+};
+
+int CachedWidth(std::string_view text,
+                const std::shared_ptr<const std::string>& owner) {
+  thread_local std::array<WidthCacheEntry, 256> cache;  // NOLINT
+  const uint64_t address = uint64_t(reinterpret_cast<uintptr_t>(text.data()));
+  const uint64_t hash = (address ^ text.size()) * 0x9E3779B97F4A7C15ULL;
+  WidthCacheEntry& entry = cache[size_t(hash >> 56)];  // NOLINT
+  if (entry.data == text.data() && entry.size == text.size() &&
+      !entry.owner.owner_before(owner) && !owner.owner_before(entry.owner)) {
+    return entry.width;
+  }
+  entry.data = text.data();
+  entry.size = text.size();
+  entry.owner = owner;
+  entry.width = string_width(text);
+  return entry.width;
+}
+
+// The number of bytes of |text| holding the glyphs starting in the first
+// |width| cells.
+size_t FittingPrefix(std::string_view text, int width) {
+  size_t start = 0;
+  while (start < text.size()) {
+    size_t end = 0;
+    uint32_t codepoint = 0;
+    if (EatCodePoint(text, start, &end, &codepoint) && !IsControl(codepoint) &&
+        !IsCombining(codepoint)) {
+      if (width <= 0) {
+        break;
+      }
+      width -= IsFullWidth(codepoint) ? 2 : 1;
+    }
+    start = end;
+  }
+  return std::min(start, text.size());
+}
+
 class Text : public Node {
  public:
-  explicit Text(std::string text) : text_(std::move(text)) {}
+  explicit Text(std::string text) : owned_(std::move(text)), text_(owned_) {}
+  explicit Text(std::shared_ptr<const std::string> text)
+      : shared_(std::move(text)), external_(true) {
+    if (shared_) {
+      text_ = *shared_;
+    }
+  }
+  explicit Text(std::string_view text) : text_(text), external_(true) {}
 
   void ComputeRequirement() override {
-    requirement_.min_x = string_width(text_);
+    if (width_ < 0) {
+      width_ =
+          external_ ? CachedWidth(text_, shared_) : MeasureText(text_).width;
+    }
+    requirement_.min_x = width_;
     requirement_.min_y = 1;
   }
 
   void Render(Screen& screen) override {
-    int x = box_.x_min;
     const int y = box_.y_min;
     if (y > box_.y_max) {
       return;
     }
-    for (const auto& cell : Utf8ToGlyphs(text_)) {
-      if (x > box_.x_max) {
-        return;
-      }
-      if (cell == "\n") {
-        continue;
-      }
-      screen.PixelAt(x, y).character = cell;
-      ++x;
-    }
+    // Only the glyphs fitting in the box are decoded.
+    const int width = box_.x_max - box_.x_min + 1;
+    const std::string_view visible =
+        text_.substr(0, FittingPrefix(text_, width));
+    screen.WriteRun(box_.x_min, y, Utf8ToGlyphs(visible), box_.x_max);
   }
 
  private:
-  std::string text_;
+  std::string owned_;
+  std::shared_ptr<const std::string> shared_;
+  std::string_view text_;
+  bool external_ = false;
+  int width_ = -1;
 };
 
 class VText : public Node {
  public:
   explicit VText(std::string text)
-      : text_(std::move(text)), width_{std::min(string_width(text_), 1)} {}
+      : text_(std::move(text)),
+        height_(MeasureText(text_).width),
+        width_{std::min(height_, 1)} {}
 
   void ComputeRequirement() override {
     requirement_.min_x = width_;
-    requirement_.min_y = string_width(text_);
+    requirement_.min_y = height_;
   }
 
   void Render(Screen& screen) override {
@@ -78,6 +140,7 @@ class VText : public Node {
 
  private:
   std::string text_;
+  int height_ = 0;
   int width_ = 1;
 };
 
@@ -102,6 +165,36 @@ Element text(std::string text) {
   return std::make_shared<Text>(std::move(text));
 }
 
+/// @brief Display a piece of UTF8 encoded unicode text, shared with the
+/// caller. It is not copied, and its width is measured once per buffer.
+/// @ingroup dom
+///
+/// ### Example
+///
+/// ```cpp
+/// auto license = std::make_shared<const std::string>(LoadLicense());
+/// Element document = text(license);
+/// ```
+Element text(std::shared_ptr<const std::string> text) {
+  return std::make_shared<Text>(std::move(text));
+}
+
+/// @brief Display a piece of UTF8 encoded unicode text, owned by the caller.
+/// It is not copied, and must outlive the element. Its width is measured once
+/// per buffer, keyed on its address and length: a buffer modified in place
+/// must be displayed with text() instead.
+/// @ingroup dom
+///
+/// ### Example
+///
+/// ```cpp
+/// static const char kBanner[] = "FTXUI";
+/// Element document = text_view(kBanner);
+/// ```
+Element text_view(std::string_view text) {
+  return std::make_shared<Text>(text);
+}
+
 /// @brief Display a piece of unicode text.
 /// @ingroup dom
 /// @see ftxui::to_wstring
@@ -0,0 +1,205 @@
+// Copyright 2020 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include "ftxui/dom/time_series.hpp"
+
+#include <algorithm>  // for clamp, max, min
+#include <atomic>     // for atomic, memory_order
+#include <cmath>      // for lround
+#include <cstddef>    // for size_t
+#include <cstdint>    // for int32_t, uint32_t, uint64_t
+#include <cstring>    // for memcpy
+#include <limits>     // for numeric_limits
+#include <memory>     // for make_unique
+#include <vector>     // for vector
+
+namespace ftxui {
+
+namespace {
+
+// A slot packs a sample with the low 32 bits of one past its index, so that
+// both are published by a single store.
+uint64_t Pack(uint64_t index, float value) {
+  uint32_t bits = 0;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return (uint64_t(bits) << 32) | uint32_t(index + 1);
+}
+
+// Compare the index stored in |slot| with |index|: negative when the slot
+// holds an older sample, 0 when it holds |index|, positive when newer.
+int32_t Compare(uint64_t slot, uint64_t index) {
+  return int32_t(uint32_t(slot) - uint32_t(index + 1));
+}
+
+float Value(uint64_t slot) {
+  const auto bits = uint32_t(slot >> 32);
+  float value = 0.F;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+}  // namespace
+
+// A slot of the ring buffer. Producers only ever move it forward to a newer
+// sample, so a producer delayed past a whole lap of the ring can't publish an
+// older sample over a newer one.
+struct TimeSeries::Slot {
+  std::atomic<uint64_t> data = 0;
+};
+
+TimeSeries::TimeSeries(size_t capacity) {
+  size_t size = 1;
+  while (size < capacity) {
+    size *= 2;
+  }
+  mask_ = size - 1;
+  slots_ = std::make_unique<Slot[]>(size);
+  for (; size; size /= 2) {
+    levels_.emplace_back(size);
+  }
+}
+
+TimeSeries::~TimeSeries() = default;
+
+/// @brief Append a sample. This can be called from any thread.
+/// @param value the sample.
+void TimeSeries::Push(float value) {
+  const uint64_t index = head_.fetch_add(1, std::memory_order_relaxed);
+  std::atomic<uint64_t>& data = slots_[index & mask_].data;
+  const uint64_t desired = Pack(index, value);
+  uint64_t current = data.load(std::memory_order_relaxed);
+  while (Compare(current, index) < 0) {
+    if (data.compare_exchange_weak(current, desired,
+                                   std::memory_order_release,
+                                   std::memory_order_relaxed)) {
+      return;
+    }
+  }
+  // Otherwise, a newer sample already took the slot. This one is dropped, as
+  // if it had been overwritten.
+}
+
+/// @brief Set the vertical range of the graph.
+/// @param min the value drawn at the bottom.
+/// @param max the value drawn at the top.
+/// When |min| >= |max|, the range fits the samples displayed.
+void TimeSeries::SetRange(float min, float max) {
+  range_min_ = min;
+  range_max_ = max;
+}
+
+// Move the samples published by the producers into the pyramid.
+void TimeSeries::Consume() {
+  const uint64_t head = head_.load(std::memory_order_acquire);
+  const uint64_t capacity = mask_ + 1;
+  if (head - consumed_ > capacity) {
+    // The producers overran the buffer. Skip the overwritten samples.
+    consumed_ = head - capacity;
+    first_ = consumed_;
+  }
+
+  for (; consumed_ < head; ++consumed_) {
+    const uint64_t data =
+        slots_[consumed_ & mask_].data.load(std::memory_order_acquire);
+    const int32_t order = Compare(data, consumed_);
+    if (order < 0) {
+      break;  // Being written. Resume on the next frame.
+    }
+    // Otherwise, a newer sample replaced this one. The previous value is
+    // repeated instead.
+    if (order == 0) {
+      last_value_ = Value(data);
+    }
+
+    for (size_t k = 0; k < levels_.size(); ++k) {
+      Range& range = levels_[k][(consumed_ >> k) & (mask_ >> k)];
+      if ((consumed_ & ((uint64_t(1) << k) - 1)) == 0) {
+        range = {last_value_, last_value_};
+      } else {
+        range.min = std::min(range.min, last_value_);
+        range.max = std::max(range.max, last_value_);
+      }
+    }
+  }
+}
+
+// The min and max of the samples in [first, last), in absolute indices. The
+// range is split into the largest aligned blocks of the pyramid.
+TimeSeries::Range TimeSeries::Query(uint64_t first, uint64_t last) const {
+  Range out = {std::numeric_limits<float>::max(),
+               std::numeric_limits<float>::lowest()};
+  while (first < last) {
+    size_t k = 0;
+    while (k + 1 < levels_.size() &&
+           (first & ((uint64_t(2) << k) - 1)) == 0 &&
+           first + (uint64_t(2) << k) <= last) {
+      ++k;
+    }
+    const Range& range = levels_[k][(first >> k) & (mask_ >> k)];
+    out.min = std::min(out.min, range.min);
+    out.max = std::max(out.max, range.max);
+    first += uint64_t(1) << k;
+  }
+  return out;
+}
+
+/// @brief The number of samples retained.
+size_t TimeSeries::size() {
+  Consume();
+  const uint64_t capacity = mask_ + 1;
+  const uint64_t oldest = consumed_ > capacity ? consumed_ - capacity : 0;
+  return size_t(consumed_ - std::max(first_, oldest));
+}
+
+/// @brief The min and max of a range of the retained samples.
+/// @param first the first sample, counted from the oldest retained.
+/// @param last one past the last sample, counted from the oldest retained.
+/// @param min receives the min. Unchanged when the range is empty.
+/// @param max receives the max. Unchanged when the range is empty.
+void TimeSeries::MinMax(size_t first, size_t last, float* min, float* max) {
+  const size_t retained = size();
+  last = std::min(last, retained);
+  if (first >= last) {
+    return;
+  }
+  const uint64_t oldest = consumed_ - retained;
+  const Range range = Query(oldest + first, oldest + last);
+  *min = range.min;
+  *max = range.max;
+}
+
+/// @brief Downsample the most recent samples for the graph element.
+/// @param width the number of values to produce.
+/// @param height the value representing the top of the range.
+std::vector<int> TimeSeries::Sample(int width, int height) {
+  std::vector<int> out(size_t(std::max(width, 0)), 0);
+  const size_t retained = size();
+  const size_t window =
+      std::min(retained, window_ ? window_ : size_t(mask_ + 1));
+  if (window == 0 || width <= 0) {
+    return out;
+  }
+  const uint64_t start = consumed_ - window;
+
+  Range range = {range_min_, range_max_};
+  if (range.min >= range.max) {
+    range = Query(start, consumed_);
+    if (range.min >= range.max) {
+      range.max = range.min + 1.F;
+    }
+  }
+  const float scale = float(height) / (range.max - range.min);
+
+  // The most recent samples are aligned to the right.
+  const size_t columns = std::min(size_t(width), window);
+  const size_t offset = size_t(width) - columns;
+  for (size_t i = 0; i < columns; ++i) {
+    const uint64_t first = start + window * i / columns;
+    const uint64_t last = start + window * (i + 1) / columns;
+    const float value = (Query(first, last).max - range.min) * scale;
+    out[offset + i] = std::clamp(int(std::lround(value)), 0, height);
+  }
+  return out;
+}
+
+}  // namespace ftxui
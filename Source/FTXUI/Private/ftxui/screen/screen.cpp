@@ -1,6 +1,7 @@
 // Copyright 2020 Arthur Sonzogni. All rights reserved.
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
+#include <algorithm>  // for fill, max, min
 #include <cstdint>  // for size_t
 #include <iostream>  // for operator<<, stringstream, basic_ostream, flush, cout, ostream
 #include <limits>
@@ -396,7 +397,7 @@ Screen::Screen(int dimx, int dimy)
     : stencil{0, dimx - 1, 0, dimy - 1},
       dimx_(dimx),
       dimy_(dimy),
-      pixels_(dimy, std::vector<Pixel>(dimx)) {
+      pixels_(size_t(std::max(dimx, 0)) * size_t(std::max(dimy, 0))) {
 #if defined(_WIN32)
   // The placement of this call is a bit weird, however we can assume that
   // anybody who instantiates a Screen object eventually wants to output
@@ -429,7 +430,9 @@ std::string Screen::ToString() const {
 
     // After printing a fullwith character, we need to skip the next cell.
     bool previous_fullwidth = false;
-    for (const auto& pixel : pixels_[y]) {
+    const Pixel* row = pixels_.data() + size_t(y) * size_t(dimx_);
+    for (const Pixel* it = row; it != row + dimx_; ++it) {
+      const Pixel& pixel = *it;
       if (!previous_fullwidth) {
         UpdatePixelStyle(this, ss, *previous_pixel_ref, pixel);
         previous_pixel_ref = &pixel;
@@ -468,14 +471,134 @@ const std::string& Screen::at(int x, int y) const {
 /// @param x The cell position along the x-axis.
 /// @param y The cell position along the y-axis.
 Pixel& Screen::PixelAt(int x, int y) {
-  return stencil.Contain(x, y) ? pixels_[y][x] : dev_null_pixel();
+  return stencil.Contain(x, y) ? pixels_[size_t(y) * size_t(dimx_) + x]
+                               : dev_null_pixel();
 }
 
 /// @brief Access a cell (Pixel) at a given position.
 /// @param x The cell position along the x-axis.
 /// @param y The cell position along the y-axis.
 const Pixel& Screen::PixelAt(int x, int y) const {
-  return stencil.Contain(x, y) ? pixels_[y][x] : dev_null_pixel();
+  return stencil.Contain(x, y) ? pixels_[size_t(y) * size_t(dimx_) + x]
+                               : dev_null_pixel();
+}
+
+/// @brief Set the style attributes selected by |mask| to their value in
+///        |value|, for every cell of |box|.
+/// @param box The area to modify. It is clipped against the stencil.
+/// @param mask A combination of Pixel::Style flags.
+/// @param value The new value of the flags selected by |mask|.
+///
+/// ```cpp
+/// // Make the box bold, and remove the dim attribute.
+/// screen.FillStyle(box, Pixel::Bold | Pixel::Dim, Pixel::Bold);
+/// ```
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+void Screen::FillStyle(const Box& box, uint8_t mask, uint8_t value) {
+  ForEachRow(box, [mask, value](Pixel* begin, Pixel* end) {
+    for (Pixel* pixel = begin; pixel != end; ++pixel) {
+      // clang-format off
+      if (mask & Pixel::Blink)            { pixel->blink = value & Pixel::Blink; }
+      if (mask & Pixel::Bold)             { pixel->bold = value & Pixel::Bold; }
+      if (mask & Pixel::Dim)              { pixel->dim = value & Pixel::Dim; }
+      if (mask & Pixel::Inverted)         { pixel->inverted = value & Pixel::Inverted; }
+      if (mask & Pixel::Underlined)       { pixel->underlined = value & Pixel::Underlined; }
+      if (mask & Pixel::UnderlinedDouble) { pixel->underlined_double = value & Pixel::UnderlinedDouble; }
+      if (mask & Pixel::Strikethrough)    { pixel->strikethrough = value & Pixel::Strikethrough; }
+      if (mask & Pixel::Automerge)        { pixel->automerge = value & Pixel::Automerge; }
+      // clang-format on
+    }
+  });
+}
+
+/// @brief Flip the style attributes selected by |mask|, for every cell of
+///        |box|.
+/// @param box The area to modify. It is clipped against the stencil.
+/// @param mask A combination of Pixel::Style flags.
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+void Screen::ToggleStyle(const Box& box, uint8_t mask) {
+  ForEachRow(box, [mask](Pixel* begin, Pixel* end) {
+    for (Pixel* pixel = begin; pixel != end; ++pixel) {
+      // clang-format off
+      if (mask & Pixel::Blink)            { pixel->blink ^= true; }
+      if (mask & Pixel::Bold)             { pixel->bold ^= true; }
+      if (mask & Pixel::Dim)              { pixel->dim ^= true; }
+      if (mask & Pixel::Inverted)         { pixel->inverted ^= true; }
+      if (mask & Pixel::Underlined)       { pixel->underlined ^= true; }
+      if (mask & Pixel::UnderlinedDouble) { pixel->underlined_double ^= true; }
+      if (mask & Pixel::Strikethrough)    { pixel->strikethrough ^= true; }
+      if (mask & Pixel::Automerge)        { pixel->automerge ^= true; }
+      // clang-format on
+    }
+  });
+}
+
+/// @brief Set the foreground or background color of every cell of |box|.
+/// @param box The area to modify. It is clipped against the stencil.
+/// @param color The color to apply.
+/// @param background Whether to set the background or the foreground color.
+void Screen::FillColor(const Box& box, Color color, bool background) {
+  if (background) {
+    ForEachRow(box, [color](Pixel* begin, Pixel* end) {
+      for (Pixel* pixel = begin; pixel != end; ++pixel) {
+        pixel->background_color = color;
+      }
+    });
+  } else {
+    ForEachRow(box, [color](Pixel* begin, Pixel* end) {
+      for (Pixel* pixel = begin; pixel != end; ++pixel) {
+        pixel->foreground_color = color;
+      }
+    });
+  }
+}
+
+/// @brief Set the hyperlink of every cell of |box|.
+/// @param box The area to modify. It is clipped against the stencil.
+/// @param hyperlink The id returned by Screen::RegisterHyperlink.
+void Screen::FillHyperlink(const Box& box, uint8_t hyperlink) {
+  ForEachRow(box, [hyperlink](Pixel* begin, Pixel* end) {
+    for (Pixel* pixel = begin; pixel != end; ++pixel) {
+      pixel->hyperlink = hyperlink;
+    }
+  });
+}
+
+/// @brief Replace every cell of |box| by |pixel|.
+/// @param box The area to modify. It is clipped against the stencil.
+/// @param pixel The value to copy.
+void Screen::Fill(const Box& box, const Pixel& pixel) {
+  ForEachRow(box, [&pixel](Pixel* begin, Pixel* end) {  //
+    std::fill(begin, end, pixel);
+  });
+}
+
+/// @brief Write consecutive glyphs on a row.
+/// @param x The column of the first glyph.
+/// @param y The row to write into.
+/// @param glyphs The glyphs to write, typically produced by Utf8ToGlyphs.
+/// @param x_max The last column that can be written.
+void Screen::WriteRun(int x,
+                      int y,
+                      const std::vector<std::string>& glyphs,
+                      int x_max) {
+  if (y < stencil.y_min || y > stencil.y_max) {
+    return;
+  }
+  x_max = std::min(x_max, stencil.x_max);
+  Pixel* row = pixels_.data() + size_t(y) * size_t(dimx_);
+  for (const auto& glyph : glyphs) {
+    if (x > x_max) {
+      return;
+    }
+    if (glyph == "\n") {
+      continue;
+    }
+    if (x >= stencil.x_min) {
+      row[x].character = glyph;
+    }
+    ++x;
+  }
 }
 
 /// @brief Return a string to be printed in order to reset the cursor position
@@ -517,11 +640,7 @@ std::string Screen::ResetPosition(bool clear) const {
 
 /// @brief Clear all the pixel from the screen.
 void Screen::Clear() {
-  for (auto& line : pixels_) {
-    for (auto& cell : line) {
-      cell = Pixel();
-    }
-  }
+  std::fill(pixels_.begin(), pixels_.end(), Pixel());
   cursor_.x = dimx_ - 1;
   cursor_.y = dimy_ - 1;
 
@@ -536,19 +655,19 @@ void Screen::ApplyShader() {
   for (int y = 0; y < dimy_; ++y) {
     for (int x = 0; x < dimx_; ++x) {
       // Box drawing character uses exactly 3 byte.
-      Pixel& cur = pixels_[y][x];
+      Pixel& cur = pixels_[y * dimx_ + x];
       if (!ShouldAttemptAutoMerge(cur)) {
         continue;
       }
 
       if (x > 0) {
-        Pixel& left = pixels_[y][x-1];
+        Pixel& left = pixels_[y * dimx_ + x - 1];
         if (ShouldAttemptAutoMerge(left)) {
           UpgradeLeftRight(left.character, cur.character);
         }
       }
       if (y > 0) {
-        Pixel& top = pixels_[y-1][x];
+        Pixel& top = pixels_[(y - 1) * dimx_ + x];
         if (ShouldAttemptAutoMerge(top)) {
           UpgradeTopDown(top.character, cur.character);
         }
@@ -11,11 +11,12 @@
 
 #include "ftxui/screen/string.hpp"
 
-#include <array>    // for array
-#include <cstddef>  // for size_t
-#include <cstdint>  // for uint32_t, uint8_t, uint16_t, int32_t
-#include <string>   // for string, basic_string, wstring
-#include <tuple>    // for _Swallow_assign, ignore
+#include <array>        // for array
+#include <cstddef>      // for size_t
+#include <cstdint>      // for uint32_t, uint8_t, uint16_t, int32_t
+#include <string>       // for string, basic_string, wstring
+#include <string_view>  // for string_view
+#include <tuple>        // for _Swallow_assign, ignore
 
 #include "ftxui/screen/deprecated.hpp"       // for wchar_width, wstring_width
 #include "ftxui/screen/string_internal.hpp"  // for WordBreakProperty, EatCodePoint, CodepointToWordBreakProperty, GlyphCount, GlyphIterate, GlyphNext, GlyphPrevious, IsCombining, IsControl, IsFullWidth, Utf8ToWordBreakProperty
@@ -1170,7 +1171,7 @@ namespace ftxui {
 // one codepoint. Put the codepoint into |ucs|. Start at |start| and update
 // |end| to represent the beginning of the next byte to eat for consecutive
 // executions.
-bool EatCodePoint(const std::string& input,
+bool EatCodePoint(std::string_view input,
                   size_t start,
                   size_t* end,
                   uint32_t* ucs) {
@@ -1326,7 +1327,7 @@ int wstring_width(const std::wstring& text) {
   return width;
 }
 
-int string_width(const std::string& input) {
+int string_width(std::string_view input) {
   int width = 0;
   size_t start = 0;
   while (start < input.size()) {
@@ -1353,7 +1354,7 @@ int string_width(const std::string& input) {
   return width;
 }
 
-std::vector<std::string> Utf8ToGlyphs(const std::string& input) {
+std::vector<std::string> Utf8ToGlyphs(std::string_view input) {
   std::vector<std::string> out;
   const std::string current;
   out.reserve(input.size());
@@ -1366,7 +1367,7 @@ std::vector<std::string> Utf8ToGlyphs(const std::string& input) {
       continue;
     }
 
-    const std::string append = input.substr(start, end - start);
+    const std::string append(input.substr(start, end - start));
     start = end;
 
     // Ignore control characters.
@@ -5,10 +5,11 @@
 #define FTXUI_SCREEN_STRING_INTERNAL_HPP
 
 #include <cstdint>
+#include <string_view>
 
 namespace ftxui {
 
-FTXUI_API bool EatCodePoint(const std::string& input,
+FTXUI_API bool EatCodePoint(std::string_view input,
                   size_t start,
                   size_t* end,
                   uint32_t* ucs);
@@ -0,0 +1,172 @@
+// Copyright 2020 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <cstddef>        // for size_t
+#include <cstdint>        // for uint32_t, uint64_t
+#include <functional>     // for hash
+#include <string>         // for string
+#include <string_view>    // for string_view
+#include <unordered_map>  // for unordered_map
+#include <vector>         // for vector
+
+#include "ftxui/screen/string.hpp"  // for TextMetrics, MeasureText, TextMetricsStats
+#include "ftxui/screen/string_internal.hpp"  // for EatCodePoint, IsCombining, IsControl, IsFullWidth
+
+namespace ftxui {
+
+namespace {
+
+// Short printable ASCII strings are measured faster than they are looked up.
+constexpr size_t kInlineLength = 16;
+// Longer strings are measured every time, so that the cache stays small.
+constexpr size_t kMaxCachedLength = 256;
+constexpr uint32_t kCapacity = 1024;
+constexpr uint32_t kNone = UINT32_MAX;
+
+bool IsPrintableAscii(std::string_view input) {
+  for (const char c : input) {
+    if (c < 0x20 || c > 0x7E) {  // NOLINT
+      return false;
+    }
+  }
+  return true;
+}
+
+// The combination of string_width and GlyphCount, in a single pass.
+TextMetrics Measure(std::string_view input) {
+  TextMetrics metrics;
+  size_t start = 0;
+  size_t end = 0;
+  while (start < input.size()) {
+    uint32_t codepoint = 0;
+    const bool eaten = EatCodePoint(input, start, &end, &codepoint);
+    start = end;
+    if (!eaten || IsControl(codepoint)) {
+      continue;
+    }
+    if (IsCombining(codepoint)) {
+      if (metrics.glyphs == 0) {
+        metrics.glyphs++;
+      }
+      continue;
+    }
+    metrics.width += IsFullWidth(codepoint) ? 2 : 1;
+    metrics.glyphs++;
+  }
+  return metrics;
+}
+
+// A least recently used cache. The entries form a doubly linked list, from the
+// most recently used |head_| to the least recently used |tail_|. They are
+// indexed by the hash of their text.
+class MetricsCache {
+ public:
+  TextMetrics Get(std::string_view input) {
+    const uint64_t hash = std::hash<std::string_view>{}(input);
+    auto it = index_.find(hash);
+    if (it != index_.end() && entries_[it->second].text == input) {
+      stats_.hits++;
+      MoveToFront(it->second);
+      return entries_[it->second].metrics;
+    }
+
+    stats_.misses++;
+    uint32_t i = 0;
+    if (it != index_.end()) {
+      // A collision. The previous string is replaced.
+      i = it->second;
+      Unlink(i);
+    } else if (entries_.size() < kCapacity) {
+      i = uint32_t(entries_.size());
+      entries_.emplace_back();
+      index_[hash] = i;
+    } else {
+      stats_.evictions++;
+      i = tail_;
+      Unlink(i);
+      index_.erase(entries_[i].hash);
+      index_[hash] = i;
+    }
+
+    Entry& entry = entries_[i];
+    entry.hash = hash;
+    entry.text = input;
+    entry.metrics = Measure(input);
+    PushFront(i);
+    return entry.metrics;
+  }
+
+  TextMetricsStats& stats() { return stats_; }
+
+ private:
+  struct Entry {
+    uint64_t hash = 0;
+    std::string text;
+    TextMetrics metrics;
+    uint32_t previous = kNone;
+    uint32_t next = kNone;
+  };
+
+  void Unlink(uint32_t i) {
+    Entry& entry = entries_[i];
+    (entry.previous == kNone ? head_ : entries_[entry.previous].next) =
+        entry.next;
+    (entry.next == kNone ? tail_ : entries_[entry.next].previous) =
+        entry.previous;
+    entry.previous = kNone;
+    entry.next = kNone;
+  }
+
+  void PushFront(uint32_t i) {
+    entries_[i].next = head_;
+    (head_ == kNone ? tail_ : entries_[head_].previous) = i;
+    head_ = i;
+  }
+
+  void MoveToFront(uint32_t i) {
+    if (head_ != i) {
+      Unlink(i);
+      PushFront(i);
+    }
+  }
+
+  std::vector<Entry> entries_;
+  std::unordered_map<uint64_t, uint32_t> index_;
+  uint32_t head_ = kNone;
+  uint32_t tail_ = kNone;
+  TextMetricsStats stats_;
+};
+
+MetricsCache& Cache() {
+  thread_local MetricsCache cache;
+  return cache;
+}
+
+}  // namespace
+
+/// @brief Measure the width and the number of glyphs of a string. The
+/// results are kept in a bounded per-thread cache, as the same labels are
+/// measured again on every frame.
+/// @param input the UTF8 encoded string.
+TextMetrics MeasureText(std::string_view input) {
+  if (input.size() <= kInlineLength && IsPrintableAscii(input)) {
+    Cache().stats().inlined++;
+    return {int(input.size()), int(input.size())};
+  }
+  if (input.size() > kMaxCachedLength) {
+    return Measure(input);
+  }
+  return Cache().Get(input);
+}
+
+/// @brief The counters of the MeasureText cache of the calling thread.
+TextMetricsStats GetTextMetricsStats() {
+  return Cache().stats();
+}
+
+/// @brief Reset the counters of the MeasureText cache of the calling thread.
+void ResetTextMetricsStats() {
+  Cache().stats() = {};
+}
+
+}  // namespace ftxui
@@ -88,6 +88,7 @@ class FTXUI_API ComponentBase {
 
  protected:
   CapturedMouse CaptureMouse(const Event& event);
+  void Invalidate(const Event& event);
 
   Components children_;
 
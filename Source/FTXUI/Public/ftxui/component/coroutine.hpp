@@ -0,0 +1,179 @@
+// Copyright 2023 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#ifndef FTXUI_COMPONENT_COROUTINE_HPP
+#define FTXUI_COMPONENT_COROUTINE_HPP
+
+#include "HAL/Platform.h"
+
+#include <chrono>       // for steady_clock
+#include <coroutine>    // for coroutine_handle, suspend_never
+#include <cstddef>      // for size_t
+#include <exception>    // for terminate
+#include <functional>   // for function
+#include <memory>       // for make_shared
+#include <optional>     // for optional
+#include <type_traits>  // for conditional_t, is_void_v
+#include <utility>      // for exchange, move
+#include <variant>      // for monostate
+
+#include "ftxui/component/event.hpp"        // for Event
+#include "ftxui/component/worker_pool.hpp"  // for Async
+
+// Usage:
+//
+// Coroutine Refresh(ScreenInteractive& screen, Table* table) {
+//   table->loading = true;
+//   co_await screen.NextFrame();
+//   table->rows = co_await screen.RunAsync(FetchRows);
+//   table->loading = false;
+//   co_await screen.Sleep(std::chrono::seconds(1));
+//   table->status = "Updated";
+//   Event event = co_await screen.NextEvent(
+//       [](const Event& event) { return event == Event::Escape; });
+// }
+//
+// The coroutine starts immediately, and is resumed on the main loop. It must
+// be started from the main loop thread. It is destroyed once finished. The
+// screen is redrawn every time the coroutine is resumed, to draw its changes.
+//
+// A coroutine awaiting a cancelled task, or a screen being destroyed, is
+// never resumed. It is destroyed instead, which runs the destructors of its
+// locals.
+
+namespace ftxui {
+
+class ScreenInteractive;
+
+// Allocate the frames of the coroutines, from a pool of blocks recycled by
+// size.
+FTXUI_API void* AllocateCoroutineFrame(size_t size);
+FTXUI_API void FreeCoroutineFrame(void* frame, size_t size);
+
+// The return type of a coroutine running on the main loop.
+class Coroutine {
+ public:
+  struct promise_type {
+    Coroutine get_return_object() { return {}; }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() {}
+    void unhandled_exception() { std::terminate(); }
+
+    static void* operator new(size_t size) {
+      return AllocateCoroutineFrame(size);
+    }
+    static void operator delete(void* frame, size_t size) {
+      FreeCoroutineFrame(frame, size);
+    }
+  };
+};
+
+// Own a suspended coroutine. Resume it once called, or destroy it if dropped
+// before.
+class SuspendedCoroutine {
+ public:
+  explicit SuspendedCoroutine(std::coroutine_handle<> handle)
+      : handle_(handle) {}
+  SuspendedCoroutine(SuspendedCoroutine&& other) noexcept
+      : handle_(std::exchange(other.handle_, nullptr)) {}
+  SuspendedCoroutine& operator=(SuspendedCoroutine&&) = delete;
+  ~SuspendedCoroutine() {
+    if (handle_) {
+      handle_.destroy();
+    }
+  }
+
+  void operator()() { std::exchange(handle_, nullptr).resume(); }
+
+ private:
+  std::coroutine_handle<> handle_;
+};
+
+// Resume once the next frame has been drawn.
+class FTXUI_API NextFrameAwaiter {
+ public:
+  explicit NextFrameAwaiter(ScreenInteractive* screen) : screen_(screen) {}
+  bool await_ready() const { return false; }
+  void await_suspend(std::coroutine_handle<> handle);
+  void await_resume() {}
+
+ private:
+  ScreenInteractive* screen_;
+};
+
+// Resume after |duration|.
+class FTXUI_API SleepAwaiter {
+ public:
+  SleepAwaiter(ScreenInteractive* screen,
+               std::chrono::steady_clock::duration duration)
+      : screen_(screen), duration_(duration) {}
+  bool await_ready() const { return duration_.count() <= 0; }
+  void await_suspend(std::coroutine_handle<> handle);
+  void await_resume() {}
+
+ private:
+  ScreenInteractive* screen_;
+  std::chrono::steady_clock::duration duration_;
+};
+
+// Resume with the next event accepted by |filter|, or any event without
+// filter. The event is still given to the components.
+class FTXUI_API NextEventAwaiter {
+ public:
+  NextEventAwaiter(ScreenInteractive* screen,
+                   std::function<bool(const Event&)> filter)
+      : screen_(screen), filter_(std::move(filter)) {}
+  bool await_ready() const { return false; }
+  void await_suspend(std::coroutine_handle<> handle);
+  Event await_resume() { return std::move(event_); }
+
+ private:
+  friend class ScreenInteractive;
+  ScreenInteractive* screen_;
+  std::function<bool(const Event&)> filter_;
+  std::coroutine_handle<> handle_;
+  Event event_;
+};
+
+// Resume on the main loop with the result of a worker task.
+template <class R>
+class AsyncAwaiter {
+ public:
+  explicit AsyncAwaiter(Async<R> async) : async_(std::move(async)) {}
+  bool await_ready() const { return false; }
+  void await_suspend(std::coroutine_handle<> handle) {
+    // The continuation owns the coroutine, and destroys it when dropped
+    // without running. The awaiter, part of the coroutine, gives up the Async
+    // so that they don't own each other.
+    auto coroutine = std::make_shared<SuspendedCoroutine>(handle);
+    Async<R> async = std::move(async_);
+    if constexpr (std::is_void_v<R>) {
+      async.Then([coroutine] { (*coroutine)(); });
+    } else {
+      async.Then([this, coroutine](R value) {
+        value_.emplace(std::move(value));
+        (*coroutine)();
+      });
+    }
+  }
+  R await_resume() {
+    if constexpr (!std::is_void_v<R>) {
+      return std::move(*value_);
+    }
+  }
+
+ private:
+  Async<R> async_;
+  std::optional<std::conditional_t<std::is_void_v<R>, std::monostate, R>>
+      value_;
+};
+
+template <class R>
+AsyncAwaiter<R> operator co_await(Async<R> async) {
+  return AsyncAwaiter<R>(std::move(async));
+}
+
+}  // namespace ftxui
+
+#endif  // FTXUI_COMPONENT_COROUTINE_HPP
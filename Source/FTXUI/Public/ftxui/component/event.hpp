@@ -72,6 +72,7 @@ FTXUI_API static const Event Custom;
 
   FTXUI_API bool is_mouse() const { return type_ == Type::Mouse; }
   FTXUI_API struct Mouse& mouse() { return data_.mouse; }
+  FTXUI_API const struct Mouse& mouse() const { return data_.mouse; }
 
   FTXUI_API bool is_cursor_reporting() const { return type_ == Type::CursorReporting; }
   FTXUI_API int cursor_x() const { return data_.cursor.x; }
@@ -32,6 +32,10 @@ struct FTXUI_API Mouse {
   // Motion
   Motion motion = Motion::Pressed;
 
+  // Whether the pointer moved, as opposed to a button being pressed or
+  // released. Only reported by terminals using the SGR mouse mode.
+  bool moved = false;
+
   // Modifiers:
   bool shift = false;
   bool meta = false;
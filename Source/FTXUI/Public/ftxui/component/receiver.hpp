@@ -6,15 +6,15 @@
 
 #include "HAL/Platform.h"
 
-#include <algorithm>           // for copy, max
-#include <atomic>              // for atomic, __atomic_base
-#include <condition_variable>  // for condition_variable
+#include <atomic>   // for atomic, memory_order
+#include <cstddef>  // for size_t
+#include <cstdint>  // for uint32_t
 #include <functional>
 #include <iostream>
-#include <memory>   // for unique_ptr, make_unique
-#include <mutex>    // for mutex, unique_lock
-#include <queue>    // for queue
-#include <utility>  // for move
+#include <memory>    // for make_shared, make_unique, shared_ptr, unique_ptr
+#include <optional>  // for optional
+#include <thread>    // for yield
+#include <utility>   // for move
 
 namespace ftxui {
 
@@ -41,6 +41,16 @@ namespace ftxui {
 //   print(c)
 //
 // Receiver::Receive() returns true when there are no more senders.
+//
+// Priority lanes:
+// ---------------
+//
+// auto receiver = MakeReceiver<std::string>(2);
+// auto urgent = receiver->MakeSender(0);
+// auto background = receiver->MakeSender(1);
+//
+// The values of the lane 0 are received before the ones of the lane 1. The
+// order is preserved within a lane.
 
 // clang-format off
 template<class T> class SenderImpl;
@@ -48,7 +58,7 @@ template<class T> class ReceiverImpl;
 
 template<class T> using Sender = std::unique_ptr<SenderImpl<T>>;
 template<class T> using Receiver = std::unique_ptr<ReceiverImpl<T>>;
-template<class T> Receiver<T> MakeReceiver();
+template<class T> Receiver<T> MakeReceiver(size_t lanes = 1);
 // clang-format on
 
 // ---- Implementation part ----
@@ -56,85 +66,292 @@ template<class T> Receiver<T> MakeReceiver();
 template <class T>
 class SenderImpl {
  public:
-  void Send(T t) { receiver_->Receive(std::move(t)); }
+  void Send(T t) { receiver_->Receive(std::move(t), lane_); }
+  void Send(T t, size_t lane) { receiver_->Receive(std::move(t), lane); }
   ~SenderImpl() { receiver_->ReleaseSender(); }
 
-  Sender<T> Clone() { return receiver_->MakeSender(); }
+  Sender<T> Clone() { return receiver_->MakeSender(lane_); }
 
  private:
   friend class ReceiverImpl<T>;
-  SenderImpl(ReceiverImpl<T>* consumer) : receiver_(consumer) {}
+  SenderImpl(ReceiverImpl<T>* consumer, size_t lane)
+      : receiver_(consumer), lane_(lane) {}
   ReceiverImpl<T>* receiver_;
+  size_t lane_;
 };
 
+// Every lane is a lock-free multiple producers single consumer linked list. A
+// producer appends its node by exchanging the |tail| of the lane, then links
+// it from the previous one. The consumer only waits on the parking |epoch|
+// when every lane is empty, and producers only wake it up when it does.
+//
+// The received nodes are recycled, so that sending doesn't allocate in the
+// steady state. Producers pop them from the |free| stack of the lane. The
+// consumer pushes them back only while no producer is popping, which
+// prevents the ABA problem of a node leaving and reentering the stack during
+// a pop. Under contention, the consumer may keep seeing a producer popping.
+// Once it holds |kRecycleLimit| nodes, it stops the new pops until it has
+// pushed them back.
 template <class T>
 class ReceiverImpl {
  public:
-  Sender<T> MakeSender() {
-    std::unique_lock<std::mutex> lock(mutex_);
-    senders_++;
-    return std::unique_ptr<SenderImpl<T>>(new SenderImpl<T>(this));
+  // Return a sender, sending to |lane| by default.
+  Sender<T> MakeSender(size_t lane = 0) {
+    parking_->senders.fetch_add(1, std::memory_order_relaxed);
+    return std::unique_ptr<SenderImpl<T>>(new SenderImpl<T>(this, lane));
   }
-  ReceiverImpl() { senders_ = 0; }
-
-  bool Receive(T* t) {
-    while (senders_ || !queue_.empty()) {
-      std::unique_lock<std::mutex> lock(mutex_);
-      if (queue_.empty())
-        notifier_.wait(lock);
-      if (queue_.empty())
-        continue;
-      *t = std::move(queue_.front());
-      queue_.pop();
-      return true;
+  explicit ReceiverImpl(size_t lanes = 1)
+      : lanes_(std::make_unique<Lane[]>(lanes)),
+        lane_count_(lanes),
+        parking_(std::make_shared<Parking>()) {}
+  ~ReceiverImpl() = default;
+  ReceiverImpl(const ReceiverImpl&) = delete;
+  ReceiverImpl& operator=(const ReceiverImpl&) = delete;
+
+  bool Receive(T* t) { return Wait() && ReceiveNonBlocking(t); }
+
+  // Block until a value is pending. Return false when there are no more
+  // senders instead.
+  bool Wait() {
+    Parking& parking = *parking_;
+    while (true) {
+      const uint32_t epoch = parking.epoch.load(std::memory_order_seq_cst);
+      if (HasPending()) {
+        return true;
+      }
+      if (!parking.senders.load(std::memory_order_seq_cst)) {
+        return HasPending();
+      }
+      parking.waiting.store(true, std::memory_order_seq_cst);
+      parking.epoch.wait(epoch, std::memory_order_seq_cst);
+      parking.waiting.store(false, std::memory_order_relaxed);
     }
-    return false;
   }
 
+  // Same as Wait(), but blocking by calling |block| instead. It must return
+  // once the notifier is called, or earlier. When it returns true, Wait()
+  // returns true as well, even if no value is pending.
+  template <class Block>
+  bool Wait(Block block) {
+    Parking& parking = *parking_;
+    while (true) {
+      const uint32_t epoch = parking.epoch.load(std::memory_order_seq_cst);
+      if (HasPending()) {
+        return true;
+      }
+      if (!parking.senders.load(std::memory_order_seq_cst)) {
+        return HasPending();
+      }
+      parking.waiting.store(true, std::memory_order_seq_cst);
+      const bool woken =
+          parking.epoch.load(std::memory_order_seq_cst) == epoch && block();
+      parking.waiting.store(false, std::memory_order_relaxed);
+      if (woken) {
+        return true;
+      }
+    }
+  }
+
+  // Set the function the producers call to wake up the consumer waiting in
+  // Wait(block).
+  void SetNotifier(void (*notifier)()) {
+    parking_->notifier.store(notifier, std::memory_order_seq_cst);
+  }
+
+  // Receive from the first non empty lane.
   bool ReceiveNonBlocking(T* t) {
-    std::unique_lock<std::mutex> lock(mutex_);
-    if (queue_.empty())
-      return false;
-    *t = queue_.front();
-    queue_.pop();
-    return true;
+    for (size_t lane = 0; lane < lane_count_; ++lane) {
+      if (lanes_[lane].Pop(t)) {
+        return true;
+      }
+    }
+    return false;
   }
 
+  // Receive from |lane| only.
+  bool ReceiveNonBlocking(T* t, size_t lane) { return lanes_[lane].Pop(t); }
+
+  // The next value of |lane|, or nullptr. It stays valid until it is received.
+  const T* Peek(size_t lane) { return lanes_[lane].Peek(); }
+
   bool HasPending() {
-    std::unique_lock<std::mutex> lock(mutex_);
-    return !queue_.empty();
+    for (size_t lane = 0; lane < lane_count_; ++lane) {
+      if (HasPending(lane)) {
+        return true;
+      }
+    }
+    return false;
   }
 
+  bool HasPending(size_t lane) { return lanes_[lane].HasPending(); }
+
   bool HasQuitted() {
-    std::unique_lock<std::mutex> lock(mutex_);
-    return queue_.empty() && !senders_;
+    return !HasPending() &&
+           !parking_->senders.load(std::memory_order_acquire);
   }
 
+  size_t lanes() const { return lane_count_; }
+
  private:
   friend class SenderImpl<T>;
 
-  void Receive(T t) {
-    {
-      std::unique_lock<std::mutex> lock(mutex_);
-      queue_.push(std::move(t));
+  static constexpr size_t kRecycleLimit = 64;
+
+  struct Node {
+    std::atomic<Node*> next = nullptr;
+    std::optional<T> value;
+  };
+
+  struct Lane {
+    Lane() : head(new Node), tail(head) {}
+    ~Lane() {
+      for (Node* node : {head, free.load(std::memory_order_relaxed), recycled}) {
+        while (node) {
+          Node* next = node->next.load(std::memory_order_relaxed);
+          delete node;
+          node = next;
+        }
+      }
+    }
+
+    void Push(T t) {
+      Node* node = Allocate();
+      node->value.emplace(std::move(t));
+      Node* previous = tail.exchange(node, std::memory_order_acq_rel);
+      previous->next.store(node, std::memory_order_release);
+    }
+
+    // Consumer side. |head| is a sentinel, whose successor holds the first
+    // value.
+    bool Pop(T* t) {
+      Node* next = head->next.load(std::memory_order_acquire);
+      if (!next) {
+        return false;
+      }
+      *t = std::move(*next->value);
+      next->value.reset();
+      Recycle(head);
+      head = next;
+      return true;
+    }
+
+    // Producer side.
+    Node* Allocate() {
+      allocating.fetch_add(1, std::memory_order_seq_cst);
+      while (flushing.load(std::memory_order_seq_cst)) {
+        allocating.fetch_sub(1, std::memory_order_seq_cst);
+        while (flushing.load(std::memory_order_seq_cst)) {
+          std::this_thread::yield();
+        }
+        allocating.fetch_add(1, std::memory_order_seq_cst);
+      }
+      Node* node = free.load(std::memory_order_seq_cst);
+      while (node && !free.compare_exchange_weak(
+                         node, node->next.load(std::memory_order_relaxed),
+                         std::memory_order_seq_cst)) {
+      }
+      allocating.fetch_sub(1, std::memory_order_seq_cst);
+      if (!node) {
+        return new Node;
+      }
+      node->next.store(nullptr, std::memory_order_relaxed);
+      return node;
+    }
+
+    // Consumer side.
+    void Recycle(Node* node) {
+      node->next.store(recycled, std::memory_order_relaxed);
+      if (!recycled) {
+        recycled_last = node;
+      }
+      recycled = node;
+      ++recycled_count;
+      if (allocating.load(std::memory_order_seq_cst) != 0) {
+        if (recycled_count < kRecycleLimit) {
+          return;
+        }
+        // Either this sees the pops in progress, or they see |flushing|.
+        flushing.store(true, std::memory_order_seq_cst);
+        while (allocating.load(std::memory_order_seq_cst) != 0) {
+          std::this_thread::yield();
+        }
+      }
+      Node* top = free.load(std::memory_order_relaxed);
+      do {
+        recycled_last->next.store(top, std::memory_order_relaxed);
+      } while (!free.compare_exchange_weak(top, recycled,
+                                           std::memory_order_seq_cst,
+                                           std::memory_order_relaxed));
+      recycled = nullptr;
+      recycled_last = nullptr;
+      recycled_count = 0;
+      flushing.store(false, std::memory_order_seq_cst);
     }
-    notifier_.notify_one();
+
+    bool HasPending() {
+      return head->next.load(std::memory_order_acquire) != nullptr;
+    }
+
+    const T* Peek() {
+      Node* next = head->next.load(std::memory_order_acquire);
+      return next ? &*next->value : nullptr;
+    }
+
+    Node* head;
+    std::atomic<Node*> tail;
+
+    std::atomic<Node*> free = nullptr;
+    std::atomic<int> allocating = 0;
+    std::atomic<bool> flushing = false;
+    Node* recycled = nullptr;  // Waiting to be pushed to |free|.
+    Node* recycled_last = nullptr;
+    size_t recycled_count = 0;
+  };
+
+  // The state the producers use to wake up the consumer. It outlives the
+  // receiver while the last sender is released: the consumer may observe
+  // there are no more senders and destroy the receiver before the notify.
+  struct Parking {
+    // Wake up the consumer, only if it is waiting. The seq_cst operations
+    // guarantee either the consumer observes the new epoch, or the producer
+    // observes |waiting|.
+    void Notify() {
+      epoch.fetch_add(1, std::memory_order_seq_cst);
+      if (!waiting.load(std::memory_order_seq_cst)) {
+        return;
+      }
+      if (auto* function = notifier.load(std::memory_order_seq_cst)) {
+        function();
+      }
+      epoch.notify_one();
+    }
+
+    std::atomic<int> senders = 0;
+    std::atomic<uint32_t> epoch = 0;
+    std::atomic<bool> waiting = false;
+    std::atomic<void (*)()> notifier = nullptr;
+  };
+
+  void Receive(T t, size_t lane) {
+    lanes_[lane].Push(std::move(t));
+    parking_->Notify();
   }
 
   void ReleaseSender() {
-    senders_--;
-    notifier_.notify_one();
+    // |this| may be destroyed as soon as |senders| is decremented.
+    const std::shared_ptr<Parking> parking = parking_;
+    parking->senders.fetch_sub(1, std::memory_order_seq_cst);
+    parking->Notify();
   }
 
-  std::mutex mutex_;
-  std::queue<T> queue_;
-  std::condition_variable notifier_;
-  std::atomic<int> senders_;
+  std::unique_ptr<Lane[]> lanes_;
+  size_t lane_count_;
+  std::shared_ptr<Parking> parking_;
 };
 
 template <class T>
-Receiver<T> MakeReceiver() {
-  return std::make_unique<ReceiverImpl<T>>();
+Receiver<T> MakeReceiver(size_t lanes) {
+  return std::make_unique<ReceiverImpl<T>>(lanes);
 }
 
 }  // namespace ftxui
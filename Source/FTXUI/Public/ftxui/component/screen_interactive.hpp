@@ -7,22 +7,33 @@
 #include "HAL/Platform.h"
 
 #include <atomic>                        // for atomic
+#include <chrono>                        // for steady_clock
+#include <coroutine>                     // for coroutine_handle
+#include <cstdint>                       // for uint64_t
 #include <ftxui/component/receiver.hpp>  // for Receiver, Sender
 #include <functional>                    // for function
 #include <memory>                        // for shared_ptr
+#include <mutex>                         // for mutex
 #include <string>                        // for string
 #include <thread>                        // for thread
+#include <type_traits>                   // for invoke_result_t
+#include <utility>                       // for move
 #include <variant>                       // for variant
+#include <vector>                        // for vector
 
 #include "ftxui/component/animation.hpp"       // for TimePoint
 #include "ftxui/component/captured_mouse.hpp"  // for CapturedMouse
+#include "ftxui/component/coroutine.hpp"       // for NextFrameAwaiter
 #include "ftxui/component/event.hpp"           // for Event
 #include "ftxui/component/task.hpp"            // for Task, Closure
+#include "ftxui/component/worker_pool.hpp"     // for WorkerPool, Async
 #include "ftxui/screen/screen.hpp"             // for Screen
 
 namespace ftxui {
 class ComponentBase;
 class Loop;
+class Reactor;
+class TimerWheel;
 struct Event;
 
 using Component = std::shared_ptr<ComponentBase>;
@@ -35,9 +46,15 @@ class FTXUI_API ScreenInteractive : public Screen {
   static ScreenInteractive Fullscreen();
   static ScreenInteractive FitComponent();
   static ScreenInteractive TerminalOutput();
+  ~ScreenInteractive();
 
   // Options. Must be called before Loop().
   void TrackMouse(bool enable = true);
+  void CoalesceRepeatedKeys(bool enable = true);
+  void UseReactor(bool enable = true);
+  void SetFrameRate(int fps);
+  void InvalidateOnEveryEvent(bool enable = true);
+  void SetWorkerCount(size_t count);
 
   // Return the currently active screen, nullptr if none.
   static ScreenInteractive* Active();
@@ -51,6 +68,30 @@ class FTXUI_API ScreenInteractive : public Screen {
   void Post(Task task);
   void PostEvent(Event event);
   void RequestAnimationFrame();
+  void Invalidate();
+
+  // Run |fn| on a worker thread. See WorkerPool.
+  template <class F>
+  Async<std::invoke_result_t<F&>> RunAsync(F fn,
+                                           CancellationToken token = {}) {
+    return Workers().Run(std::move(fn), std::move(token));
+  }
+  WorkerPool& Workers();
+
+  // Timers, run on the main loop thread, and set from it.
+  uint64_t SetTimeout(ClosureTask fn,
+                      std::chrono::steady_clock::duration delay);
+  uint64_t SetInterval(ClosureTask fn,
+                       std::chrono::steady_clock::duration period);
+  void ClearTimer(uint64_t id);
+  Closure Debounce(Closure fn, std::chrono::steady_clock::duration delay);
+  Closure Throttle(Closure fn, std::chrono::steady_clock::duration period);
+
+  // Awaitables, resuming a coroutine on the main loop. See Coroutine.
+  NextFrameAwaiter NextFrame();
+  SleepAwaiter Sleep(std::chrono::steady_clock::duration duration);
+  NextEventAwaiter NextEvent(
+      std::function<bool(const Event&)> filter = nullptr);
 
   CapturedMouse CaptureMouse();
 
@@ -62,6 +103,9 @@ class FTXUI_API ScreenInteractive : public Screen {
  private:
   void ExitNow();
 
+  void PostContinuation(ClosureTask task);
+  void OpenClosureLane();
+
   void Install();
   void Uninstall();
 
@@ -73,6 +117,7 @@ class FTXUI_API ScreenInteractive : public Screen {
   void RunOnceBlocking(Component component);
 
   void HandleTask(Component component, Task& task);
+  void ResumeEventWaiters(const Event& event);
   void Draw(Component component);
   void ResetCursorPosition();
 
@@ -93,6 +138,8 @@ class FTXUI_API ScreenInteractive : public Screen {
                     bool use_alternative_screen);
 
   bool track_mouse_ = true;
+  bool coalesce_repeated_keys_ = false;
+  bool invalidate_on_every_event_ = false;
 
   Sender<Task> task_sender_;
   Receiver<Task> task_receiver_;
@@ -103,6 +150,8 @@ class FTXUI_API ScreenInteractive : public Screen {
   std::atomic<bool> quit_ = false;
   std::thread event_listener_;
   std::thread animation_listener_;
+  bool use_reactor_ = false;
+  std::unique_ptr<Reactor> reactor_;
   bool animation_requested_ = false;
   animation::TimePoint previous_animation_time_;
 
@@ -113,8 +162,29 @@ class FTXUI_API ScreenInteractive : public Screen {
   bool previous_frame_resized_ = false;
 
   bool frame_valid_ = false;
+  std::chrono::steady_clock::duration frame_budget_ =
+      std::chrono::milliseconds(1000) / 60;  // NOLINT
+  std::chrono::steady_clock::time_point next_frame_;
+  bool synchronized_output_ = false;
+
+  std::unique_ptr<TimerWheel> timers_;
+
+  // The suspended coroutines.
+  std::vector<std::coroutine_handle<>> frame_waiters_;
+  std::vector<NextEventAwaiter*> event_waiters_;
+
+  // The continuations of the workers, posted while the loop isn't running.
+  // |task_sender_| is only set or reset with |continuations_mutex_| held.
+  std::mutex continuations_mutex_;
+  std::vector<ClosureTask> pending_continuations_;
+
+  size_t worker_count_ = 0;
+  // Last, so that the workers stop first.
+  std::unique_ptr<WorkerPool> worker_pool_;
 
   friend class Loop;
+  friend class NextFrameAwaiter;
+  friend class NextEventAwaiter;
 
  public:
   class Private {
@@ -6,14 +6,126 @@
 
 #include "HAL/Platform.h"
 
-#include <functional>
-#include <variant>
+#include <cstddef>      // for size_t, max_align_t
+#include <functional>   // for function
+#include <new>          // for launder
+#include <type_traits>  // for decay_t, enable_if_t, is_invocable_r_v
+#include <utility>      // for forward, move
+#include <variant>      // for variant
+
 #include "ftxui/component/event.hpp"
 
 namespace ftxui {
 class AnimationTask {};
 using Closure = std::function<void()>;
-using Task = std::variant<Event, Closure, AnimationTask>;
+
+// A move only `void()` callable, posted to the main loop. Unlike Closure, the
+// callables up to |kInlineSize| bytes are stored inline, without allocating.
+// They can also capture move only values.
+class ClosureTask {
+ public:
+  static constexpr size_t kInlineSize = 48;
+
+  ClosureTask() = default;
+
+  template <class F,
+            class Functor = std::decay_t<F>,
+            class = std::enable_if_t<!std::is_same_v<Functor, ClosureTask> &&
+                                     std::is_invocable_r_v<void, Functor&>>>
+  ClosureTask(F&& f) {  // NOLINT
+    if constexpr (IsInline<Functor>()) {
+      new (&storage_) Functor(std::forward<F>(f));
+    } else {
+      *reinterpret_cast<Functor**>(&storage_) =  // NOLINT
+          new Functor(std::forward<F>(f));
+    }
+    ops_ = &kOps<Functor>;
+  }
+
+  ClosureTask(ClosureTask&& other) noexcept { MoveFrom(other); }
+  ClosureTask& operator=(ClosureTask&& other) noexcept {
+    if (this != &other) {
+      Reset();
+      MoveFrom(other);
+    }
+    return *this;
+  }
+  ClosureTask(const ClosureTask&) = delete;
+  ClosureTask& operator=(const ClosureTask&) = delete;
+  ~ClosureTask() { Reset(); }
+
+  // An empty task, default constructed or moved from, does nothing.
+  void operator()() {
+    if (ops_) {
+      ops_->invoke(&storage_);
+    }
+  }
+  explicit operator bool() const { return ops_ != nullptr; }
+
+ private:
+  struct Ops {
+    void (*invoke)(void* storage);
+    // Move construct |to| from |from|, and destroy |from|.
+    void (*move)(void* from, void* to);
+    void (*destroy)(void* storage);
+  };
+
+  template <class F>
+  static constexpr bool IsInline() {
+    return sizeof(F) <= kInlineSize && alignof(F) <= alignof(std::max_align_t) &&
+           std::is_nothrow_move_constructible_v<F>;
+  }
+
+  template <class F>
+  static F* Get(void* storage) {
+    if constexpr (IsInline<F>()) {
+      return std::launder(reinterpret_cast<F*>(storage));  // NOLINT
+    } else {
+      return *reinterpret_cast<F**>(storage);  // NOLINT
+    }
+  }
+
+  template <class F>
+  static constexpr Ops kOps = {
+      [](void* storage) { (*Get<F>(storage))(); },
+      [](void* from, void* to) {
+        if constexpr (IsInline<F>()) {
+          F* functor = Get<F>(from);
+          new (to) F(std::move(*functor));
+          functor->~F();
+        } else {
+          *reinterpret_cast<F**>(to) = Get<F>(from);  // NOLINT
+        }
+      },
+      [](void* storage) {
+        if constexpr (IsInline<F>()) {
+          Get<F>(storage)->~F();
+        } else {
+          delete Get<F>(storage);
+        }
+      },
+  };
+
+  void MoveFrom(ClosureTask& other) {
+    ops_ = other.ops_;
+    if (ops_) {
+      ops_->move(&other.storage_, &storage_);
+      other.ops_ = nullptr;
+    }
+  }
+
+  void Reset() {
+    if (ops_) {
+      ops_->destroy(&storage_);
+      ops_ = nullptr;
+    }
+  }
+
+  alignas(std::max_align_t) unsigned char storage_[kInlineSize];  // NOLINT
+  const Ops* ops_ = nullptr;
+};
+
+using Task = std::variant<Event, ClosureTask, AnimationTask>;
 }  // namespace ftxui
 
 #endif  // FTXUI_COMPONENT_ANIMATION_HPP
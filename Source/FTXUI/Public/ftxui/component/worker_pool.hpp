@@ -0,0 +1,236 @@
+// Copyright 2023 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#ifndef FTXUI_COMPONENT_WORKER_POOL_HPP
+#define FTXUI_COMPONENT_WORKER_POOL_HPP
+
+#include "HAL/Platform.h"
+
+#include <atomic>              // for atomic
+#include <condition_variable>  // for condition_variable
+#include <cstddef>             // for size_t
+#include <deque>               // for deque
+#include <functional>          // for function
+#include <memory>              // for shared_ptr, make_shared, unique_ptr
+#include <mutex>               // for mutex, lock_guard
+#include <optional>            // for optional
+#include <thread>              // for thread
+#include <type_traits>  // for conditional_t, invoke_result_t, is_void_v
+#include <utility>      // for move
+#include <variant>      // for monostate
+#include <vector>       // for vector
+
+#include "ftxui/component/task.hpp"  // for ClosureTask
+
+// Usage:
+//
+// Cancellation cancellation;  // Typically a member of a component.
+// screen.RunAsync([rows] { return Sort(rows); }, cancellation.Token())
+//     .Then([this](Rows sorted) { rows_ = std::move(sorted); });
+//
+// The function runs on a worker thread. The continuation runs on the main
+// loop, unless the Cancellation was cancelled or destroyed meanwhile. The
+// screen is redrawn after it, to show the new state. The continuations that
+// don't run are destroyed on the main loop as well. The ones posted while the
+// loop isn't running wait for it to run again.
+
+namespace ftxui {
+
+// Tell whether the work it was given to must be abandoned. A default
+// constructed token is never cancelled.
+class CancellationToken {
+ public:
+  CancellationToken() = default;
+  bool IsCancelled() const {
+    return cancelled_ && cancelled_->load(std::memory_order_acquire);
+  }
+
+ private:
+  friend class Cancellation;
+  explicit CancellationToken(std::shared_ptr<std::atomic<bool>> cancelled)
+      : cancelled_(std::move(cancelled)) {}
+  std::shared_ptr<std::atomic<bool>> cancelled_;
+};
+
+// Cancel every token it gave, when Cancel() is called or when destroyed. This
+// ties the work to the lifetime of its owner.
+class Cancellation {
+ public:
+  Cancellation() : cancelled_(std::make_shared<std::atomic<bool>>(false)) {}
+  ~Cancellation() { Cancel(); }
+  Cancellation(const Cancellation&) = delete;
+  Cancellation& operator=(const Cancellation&) = delete;
+
+  void Cancel() { cancelled_->store(true, std::memory_order_release); }
+  CancellationToken Token() const { return CancellationToken(cancelled_); }
+
+ private:
+  std::shared_ptr<std::atomic<bool>> cancelled_;
+};
+
+// The function receiving a result of type |R|.
+template <class R>
+struct AsyncContinuation {
+  using type = std::function<void(R)>;
+};
+template <>
+struct AsyncContinuation<void> {
+  using type = std::function<void()>;
+};
+
+// The result of WorkerPool::Run(), whose type is |R|.
+template <class R>
+class Async {
+ public:
+  using Continuation = typename AsyncContinuation<R>::type;
+
+  // Run |continuation| on the main loop with the result, once available.
+  void Then(Continuation continuation) {
+    state_->Then(std::move(continuation));
+  }
+
+ private:
+  friend class WorkerPool;
+  using Value = std::conditional_t<std::is_void_v<R>, std::monostate, R>;
+
+  // Shared by the worker producing the value and the owner of the Async
+  // attaching the continuation. The last of the two posts the continuation.
+  struct State {
+    // Shared with the pool, which may be destroyed before the continuation is
+    // attached.
+    std::shared_ptr<const std::function<void(ClosureTask)>> post;
+    CancellationToken token;
+    std::mutex mutex;
+    std::optional<Value> value;
+    Continuation continuation;
+    bool abandoned = false;
+
+    void Complete(Value v) {
+      Continuation c;
+      {
+        const std::lock_guard<std::mutex> lock(mutex);
+        if (!continuation) {
+          value = std::move(v);
+          return;
+        }
+        c = std::move(continuation);
+      }
+      Deliver(std::move(c), std::move(v));
+    }
+
+    // The token was cancelled before the work started. The continuation is
+    // dropped on the main loop, like the ones delivered.
+    void Abandon();
+
+    void Then(Continuation c) {
+      std::optional<Value> v;
+      {
+        const std::lock_guard<std::mutex> lock(mutex);
+        if (abandoned) {
+          return;
+        }
+        if (!value) {
+          continuation = std::move(c);
+          return;
+        }
+        v = std::move(value);
+      }
+      Deliver(std::move(c), std::move(*v));
+    }
+
+    void Deliver(Continuation c, Value v);
+  };
+
+  explicit Async(std::shared_ptr<State> state) : state_(std::move(state)) {}
+  std::shared_ptr<State> state_;
+};
+
+// A fixed set of threads running functions outside of the main loop. Every
+// worker has its own queue, and steals from the others when it is empty.
+class FTXUI_API WorkerPool {
+ public:
+  // |post| runs the continuations on the main loop. The functions pending
+  // when the pool is destroyed still run, and post their continuations. It is
+  // shared with the Async, so it can still be called after the pool is gone.
+  WorkerPool(std::function<void(ClosureTask)> post, size_t workers);
+  ~WorkerPool();
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+
+  // Run |fn| on a worker, unless |token| is cancelled before it starts.
+  template <class F>
+  Async<std::invoke_result_t<F&>> Run(F fn, CancellationToken token = {}) {
+    using R = std::invoke_result_t<F&>;
+    using State = typename Async<R>::State;
+    auto state = std::make_shared<State>();
+    state->post = post_;
+    state->token = std::move(token);
+    Submit([fn = std::move(fn), state]() mutable {
+      if (state->token.IsCancelled()) {
+        state->Abandon();
+        return;
+      }
+      if constexpr (std::is_void_v<R>) {
+        fn();
+        state->Complete(std::monostate());
+      } else {
+        state->Complete(fn());
+      }
+    });
+    return Async<R>(std::move(state));
+  }
+
+  size_t workers() const { return threads_.size(); }
+
+ private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<ClosureTask> tasks;
+  };
+
+  void Submit(ClosureTask task);
+  bool Pop(size_t worker, ClosureTask* task);
+  void Work(size_t worker);
+
+  std::shared_ptr<const std::function<void(ClosureTask)>> post_;
+  std::vector<std::unique_ptr<Queue>> queues_;
+  std::vector<std::thread> threads_;
+  std::atomic<size_t> next_queue_ = 0;
+
+  // The workers sleep when every queue is empty.
+  std::mutex mutex_;
+  std::condition_variable wakeup_;
+  std::atomic<size_t> pending_ = 0;
+  bool quit_ = false;
+};
+
+template <class R>
+void Async<R>::State::Abandon() {
+  Continuation c;
+  {
+    const std::lock_guard<std::mutex> lock(mutex);
+    abandoned = true;
+    c = std::move(continuation);
+  }
+  if (c) {
+    (*post)([c = std::move(c)] {});
+  }
+}
+
+template <class R>
+void Async<R>::State::Deliver(Continuation c, Value v) {
+  (*post)([c = std::move(c), v = std::move(v), token = token]() mutable {
+    if (token.IsCancelled()) {
+      return;
+    }
+    if constexpr (std::is_void_v<R>) {
+      c();
+    } else {
+      c(std::move(v));
+    }
+  });
+}
+
+}  // namespace ftxui
+
+#endif  // FTXUI_COMPONENT_WORKER_POOL_HPP
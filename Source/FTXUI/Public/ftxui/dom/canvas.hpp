@@ -6,13 +6,19 @@
 
 #include "HAL/Platform.h"
 
+#include <algorithm>      // for max, min
+#include <climits>        // for INT_MAX, INT_MIN
 #include <cstddef>        // for size_t
+#include <cstdint>        // for uint8_t, uint32_t, UINT32_MAX
 #include <functional>     // for function
+#include <span>           // for span
 #include <string>         // for string
 #include <unordered_map>  // for unordered_map
+#include <vector>         // for vector
 
+#include "ftxui/screen/box.hpp"     // for Box
 #include "ftxui/screen/color.hpp"   // for Color
-#include "ftxui/screen/screen.hpp"  // for Pixel
+#include "ftxui/screen/screen.hpp"  // for Pixel, Screen
 
 #ifdef DrawText
 // Workaround for WinUsr.h (via Windows.h) defining macros that break things.
@@ -32,6 +38,18 @@ struct FTXUI_API Canvas {
   int height() const { return height_; }
   Pixel GetPixel(int x, int y) const;
 
+  // Copy the cells into a screen area.
+  void Blit(Screen& screen, const Box& box) const;
+
+  // Retained mode -------------------------------------------------------------
+  // The canvas remembers its cells converted into pixels. BlitRetained only
+  // converts again the cells modified since its previous call.
+  void BlitRetained(Screen& screen, const Box& box) const;
+  // The cells modified since the last BlitRetained, in cell coordinates.
+  const Box& dirty() const { return dirty_; }
+  // Erase everything, keeping the memory allocated.
+  void Clear();
+
   using Stylizer = std::function<void(Pixel&)>;
 
   // Draws using braille characters --------------------------------------------
@@ -89,6 +107,50 @@ struct FTXUI_API Canvas {
                               int r2,
                               const Color& color);
 
+  // Batched braille dots -----------------------------------------------------
+  // Draw many dots sharing a single style. Dots outside of the canvas are
+  // skipped. The stylizer runs once per distinct style met, not per dot.
+  struct Point {
+    int x = 0;
+    int y = 0;
+  };
+  // Draw every point.
+  void DrawPoints(std::span<const Point> points);
+  void DrawPoints(std::span<const Point> points, const Stylizer& s);
+  void DrawPoints(std::span<const Point> points, const Color& color);
+  // Draw lines in between consecutive points.
+  void DrawPolyline(std::span<const Point> points);
+  void DrawPolyline(std::span<const Point> points, const Stylizer& s);
+  void DrawPolyline(std::span<const Point> points, const Color& color);
+  // Draw one line per pair of points.
+  void DrawSegments(std::span<const Point> points);
+  void DrawSegments(std::span<const Point> points, const Stylizer& s);
+  void DrawSegments(std::span<const Point> points, const Color& color);
+  // Draw one dot per sample, at (x + i, ys[i]).
+  void DrawScatter(int x, std::span<const int> ys);
+  void DrawScatter(int x, std::span<const int> ys, const Stylizer& s);
+  void DrawScatter(int x, std::span<const int> ys, const Color& color);
+
+  // Filled polygons -----------------------------------------------------------
+  // Filled using the even-odd rule, one row of cells at a time. The outline is
+  // included.
+  void DrawPointPolygonFilled(const std::vector<Point>& points);
+  void DrawPointPolygonFilled(const std::vector<Point>& points,
+                              const Stylizer& s);
+  void DrawPointPolygonFilled(const std::vector<Point>& points,
+                              const Color& color);
+  void DrawPointTriangleFilled(Point a, Point b, Point c);
+  void DrawPointTriangleFilled(Point a, Point b, Point c, const Stylizer& s);
+  void DrawPointTriangleFilled(Point a, Point b, Point c, const Color& color);
+  void DrawBlockPolygonFilled(const std::vector<Point>& points);
+  void DrawBlockPolygonFilled(const std::vector<Point>& points,
+                              const Stylizer& s);
+  void DrawBlockPolygonFilled(const std::vector<Point>& points,
+                              const Color& color);
+  void DrawBlockTriangleFilled(Point a, Point b, Point c);
+  void DrawBlockTriangleFilled(Point a, Point b, Point c, const Stylizer& s);
+  void DrawBlockTriangleFilled(Point a, Point b, Point c, const Color& color);
+
   // Draw using normal characters ----------------------------------------------
   // Draw using character of size 2x4 at position (x,y)
   // x is considered to be a multiple of 2.
@@ -106,33 +168,70 @@ struct FTXUI_API Canvas {
   bool IsIn(int x, int y) const {
     return x >= 0 && x < width_ && y >= 0 && y < height_;
   }
-  enum CellType {
+  enum CellType : uint8_t {
     kBraille,
     kBlock,
     kText,
   };
+
+  // A cell is a 2x4 braille dots, or a 2x2 blocks, or a single glyph. Its
+  // character is only produced when it is read back.
   struct Cell {
+    uint32_t style = 0;  // Index into |styles_|.
+    uint8_t mask = 0;    // The braille dots or the blocks drawn.
     CellType type = kText;
-    Pixel content;
   };
-  struct XY {
-    int x;
-    int y;
-    bool operator==(const XY& other) const {
-      return x == other.x && y == other.y;
-    }
-  };
-
-  struct XYHash {
-    size_t operator()(const XY& xy) const {
-      constexpr size_t shift = 1024;
-      return size_t(xy.x) * shift + size_t(xy.y);
-    }
+  Cell& CellAt(int x, int y) {
+    x /= 2;
+    y /= 4;
+    dirty_.x_min = std::min(dirty_.x_min, x);
+    dirty_.x_max = std::max(dirty_.x_max, x);
+    dirty_.y_min = std::min(dirty_.y_min, y);
+    dirty_.y_max = std::max(dirty_.y_max, y);
+    return cells_[size_t(y) * size_t(cells_x_) + size_t(x)];
+  }
+  void ToPixel(const Cell& cell, Pixel& pixel) const;
+  Cell& BrailleCellAt(int x, int y);
+  Cell& BlockCellAt(int x, int y);
+
+  // Styles are shared in between cells. A text cell also stores its glyph in
+  // its style.
+  uint32_t Intern(const Pixel& pixel);
+  void CompactStyles();
+
+  // The style applied by the batched functions. The last transition is
+  // remembered, so that the stylizer runs once per distinct style met. The
+  // stylizer is assumed to be idempotent.
+  struct Brush {
+    const Color* color = nullptr;
+    const Stylizer* style = nullptr;
+    uint32_t generation = 0;
+    uint32_t from = UINT32_MAX;
+    uint32_t to = UINT32_MAX;
   };
+  void Restyle(Cell& cell, Brush& brush);
+  using Plot = void (Canvas::*)(int x, int y, Brush& brush);
+  void DotOn(int x, int y, Brush& brush);
+  void BlockOn(int x, int y, Brush& brush);
+  void LineOn(Point a, Point b, Brush& brush, Plot plot = &Canvas::DotOn);
+  void PolygonOn(const std::vector<Point>& points, bool block, Brush brush);
+  void PointsOn(std::span<const Point> points, Brush brush);
+  void PolylineOn(std::span<const Point> points, Brush brush);
+  void SegmentsOn(std::span<const Point> points, Brush brush);
+  void ScatterOn(int x, std::span<const int> ys, Brush brush);
 
   int width_ = 0;
   int height_ = 0;
-  std::unordered_map<XY, Cell, XYHash> storage_;
+  int cells_x_ = 0;
+  std::vector<Cell> cells_;
+  std::vector<Pixel> styles_ = {Pixel()};
+  std::unordered_map<std::string, uint32_t> styles_index_;
+  uint32_t last_style_ = 0;
+  uint32_t styles_generation_ = 0;  // Incremented by CompactStyles.
+
+  // Retained mode:
+  mutable std::vector<Pixel> pixels_;  // |cells_| converted into pixels.
+  mutable Box dirty_ = {INT_MAX, INT_MIN, INT_MAX, INT_MIN};
 };
 
 }  // namespace ftxui
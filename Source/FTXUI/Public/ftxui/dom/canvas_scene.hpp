@@ -0,0 +1,88 @@
+// Copyright 2021 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#ifndef FTXUI_DOM_CANVAS_SCENE_HPP
+#define FTXUI_DOM_CANVAS_SCENE_HPP
+
+#include "HAL/Platform.h"
+
+#include <cstddef>  // for size_t
+#include <cstdint>  // for uint32_t
+#include <vector>   // for vector
+
+#include "ftxui/dom/canvas.hpp"    // for Canvas
+#include "ftxui/screen/color.hpp"  // for Color
+
+namespace ftxui {
+
+/// @brief A set of points and lines in world coordinates, drawn onto a Canvas
+/// through a view that can be panned and zoomed.
+///
+/// The primitives are indexed by a grid of buckets covering their bounds, so
+/// that drawing only visits the primitives near the view. Lines crossing the
+/// view are clipped before being rasterized. Primitives of the same color are
+/// drawn together, so the order in which they overlap is unspecified.
+///
+/// @ingroup dom
+class FTXUI_API CanvasScene {
+ public:
+  // Primitives, in world coordinates ------------------------------------------
+  void AddPoint(double x, double y, const Color& color = Color());
+  void AddLine(double x1,
+               double y1,
+               double x2,
+               double y2,
+               const Color& color = Color());
+  void Clear();
+  size_t size() const { return primitives_.size(); }
+
+  // View ----------------------------------------------------------------------
+  // The world rectangle mapped onto the canvas. The y axis points up.
+  void SetView(double x_min, double x_max, double y_min, double y_max);
+  void Pan(double dx, double dy);
+  void Zoom(double factor, double x, double y);
+  double view_x_min() const { return view_x_min_; }
+  double view_x_max() const { return view_x_max_; }
+  double view_y_min() const { return view_y_min_; }
+  double view_y_max() const { return view_y_max_; }
+
+  // Draw the primitives in view. Return the number of primitives visited.
+  size_t Draw(Canvas& canvas);
+
+ private:
+  struct Primitive {
+    double x1;
+    double y1;
+    double x2;
+    double y2;
+    Color color;
+  };
+  void BuildIndex();
+  int BucketX(double x) const;
+  int BucketY(double y) const;
+
+  std::vector<Primitive> primitives_;
+
+  double view_x_min_ = 0.0;
+  double view_x_max_ = 1.0;
+  double view_y_min_ = 0.0;
+  double view_y_max_ = 1.0;
+
+  // The bucket index. Rebuilt on Draw, after the primitives changed.
+  bool index_valid_ = false;
+  double x_min_ = 0.0;
+  double y_min_ = 0.0;
+  double bucket_width_ = 1.0;
+  double bucket_height_ = 1.0;
+  int buckets_x_ = 0;
+  int buckets_y_ = 0;
+  std::vector<uint32_t> bucket_begin_;  // Offsets into |bucket_items_|.
+  std::vector<uint32_t> bucket_items_;  // Indices into |primitives_|.
+  std::vector<uint32_t> large_items_;   // Spanning too many buckets.
+  std::vector<uint32_t> visited_;       // Draw stamp of each primitive.
+  uint32_t stamp_ = 0;
+};
+
+}  // namespace ftxui
+
+#endif  // FTXUI_DOM_CANVAS_SCENE_HPP
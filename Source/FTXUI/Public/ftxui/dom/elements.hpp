@@ -6,8 +6,14 @@
 
 #include "HAL/Platform.h"
 
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
 
 #include "ftxui/dom/canvas.hpp"
 #include "ftxui/dom/direction.hpp"
@@ -22,11 +28,21 @@
 
 namespace ftxui {
 class Node;
+class TimeSeries;
 using Element = std::shared_ptr<Node>;
 using Elements = std::vector<Element>;
 using Decorator = std::function<Element(Element)>;
 using GraphFunction = std::function<std::vector<int>(int, int)>;
 
+// A range of a styledText, and the style applied to it.
+struct StyleRun {
+  size_t begin = 0;   // Byte offset of the first character.
+  size_t end = 0;     // Byte offset past the last character.
+  uint8_t style = 0;  // A combination of Pixel::Style flags.
+  std::optional<Color> foreground_color;
+  std::optional<Color> background_color;
+};
+
 enum BorderStyle {
   LIGHT,
   DASHED,
@@ -47,6 +63,8 @@ FTXUI_API Decorator operator|(Decorator, Decorator);
 
 // --- Widget ---
 FTXUI_API Element text(std::string text);
+FTXUI_API Element text(std::shared_ptr<const std::string> text);
+FTXUI_API Element text_view(std::string_view text);
 FTXUI_API Element vtext(std::string text);
 FTXUI_API Element separator();
 FTXUI_API Element separatorLight();
@@ -84,14 +102,30 @@ FTXUI_API Decorator borderStyled(Color);
 FTXUI_API Decorator borderWith(const Pixel&);
 FTXUI_API Element window(Element title, Element content);
 FTXUI_API Element spinner(int charset_index, size_t image_index);
+FTXUI_API Element styledText(std::string text, std::vector<StyleRun> runs);
+FTXUI_API Element styledParagraph(std::string text, std::vector<StyleRun> runs);
 FTXUI_API Element paragraph(const std::string& text);
 FTXUI_API Element paragraphAlignLeft(const std::string& text);
 FTXUI_API Element paragraphAlignRight(const std::string& text);
 FTXUI_API Element paragraphAlignCenter(const std::string& text);
 FTXUI_API Element paragraphAlignJustify(const std::string& text);
 FTXUI_API Element graph(GraphFunction);
+FTXUI_API Element graph(std::shared_ptr<TimeSeries>);
+FTXUI_API Element heatmap(std::span<const float> values,
+                          int width,
+                          int height,
+                          std::function<Color(float)> colormap);
+FTXUI_API Element heatmap(std::span<const float> values,
+                          int width,
+                          int height,
+                          Color low,
+                          Color high);
+FTXUI_API Element image(std::span<const uint8_t> rgba,
+                        int width,
+                        int height);
 FTXUI_API Element emptyElement();
 FTXUI_API Element canvas(ConstRef<Canvas>);
+FTXUI_API Element canvasRetained(ConstRef<Canvas>);
 FTXUI_API Element canvas(int width, int height, std::function<void(Canvas&)>);
 FTXUI_API Element canvas(std::function<void(Canvas&)>);
 
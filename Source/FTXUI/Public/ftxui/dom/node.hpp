@@ -17,6 +17,7 @@ namespace ftxui {
 
 class Node;
 class Screen;
+class StyleNode;
 
 using Element = std::shared_ptr<Node>;
 using Elements = std::vector<Element>;
@@ -45,6 +46,11 @@ class FTXUI_API Node {
   // Step 3: Draw this element.
   virtual void Render(Screen& screen);
 
+  // Whether the box assigned in Step 2 intersects the screen's stencil. When it
+  // doesn't, rendering this element can't modify the screen and can be
+  // skipped. Containers use this to cull their invisible children.
+  bool IsVisible(const Screen& screen) const;
+
   // Layout may not resolve within a single iteration for some elements. This
   // allows them to request additionnal iterations. This signal must be
   // forwarded to children at least once.
@@ -58,6 +64,12 @@ class FTXUI_API Node {
   Elements children_;
   Requirement requirement_;
   Box box_;
+
+ private:
+  // Chains of style decorators are fused into a single StyleNode. This lets it
+  // recognize its own instances without relying on RTTI.
+  friend class StyleNode;
+  virtual StyleNode* AsStyleNode() { return nullptr; }
 };
 
 FTXUI_API void Render(Screen& screen, const Element& element);
@@ -0,0 +1,80 @@
+// Copyright 2020 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#ifndef FTXUI_DOM_TIME_SERIES_HPP
+#define FTXUI_DOM_TIME_SERIES_HPP
+
+#include "HAL/Platform.h"
+
+#include <atomic>   // for atomic
+#include <cstddef>  // for size_t
+#include <cstdint>  // for uint64_t
+#include <memory>   // for unique_ptr
+#include <vector>   // for vector
+
+namespace ftxui {
+
+/// @brief A history of samples, fed by any number of threads and displayed by
+/// the `graph` element.
+///
+/// Samples are appended to a lock-free ring buffer. The UI thread moves them
+/// into a min/max pyramid, so that the max of any range of samples is read in
+/// O(log(capacity)). Drawing a frame is then independent of the number of
+/// samples displayed.
+///
+/// Push() can be called from any thread. The other functions are meant to be
+/// called from the UI thread.
+///
+/// @ingroup dom
+class FTXUI_API TimeSeries {
+ public:
+  // |capacity| is rounded up to a power of two.
+  explicit TimeSeries(size_t capacity = 1 << 16);
+  ~TimeSeries();
+  TimeSeries(const TimeSeries&) = delete;
+  TimeSeries& operator=(const TimeSeries&) = delete;
+
+  // Append a sample. Thread safe, lock-free.
+  void Push(float value);
+
+  // Number of most recent samples displayed. 0 means the whole capacity.
+  void SetWindow(size_t samples) { window_ = samples; }
+  // Fixed vertical range. When |min| >= |max|, the range fits the samples.
+  void SetRange(float min, float max);
+
+  // Number of samples retained.
+  size_t size();
+  // The min and max of the samples in [first, last), counted from the oldest
+  // sample retained.
+  void MinMax(size_t first, size_t last, float* min, float* max);
+  // Downsample the window to |width| values in [0, height], as expected by a
+  // GraphFunction. Each value is the max of the samples it covers.
+  std::vector<int> Sample(int width, int height);
+
+ private:
+  struct Slot;
+  struct Range {
+    float min;
+    float max;
+  };
+  void Consume();
+  Range Query(uint64_t first, uint64_t last) const;
+
+  // Shared with the producers:
+  size_t mask_;
+  std::unique_ptr<Slot[]> slots_;
+  std::atomic<uint64_t> head_ = 0;
+
+  // UI thread only:
+  std::vector<std::vector<Range>> levels_;  // levels_[k] covers 2^k samples.
+  uint64_t first_ = 0;     // First sample consumed after the last overrun.
+  uint64_t consumed_ = 0;  // Samples moved into |levels_|.
+  float last_value_ = 0.F;
+  size_t window_ = 0;
+  float range_min_ = 0.F;
+  float range_max_ = 0.F;
+};
+
+}  // namespace ftxui
+
+#endif  // FTXUI_DOM_TIME_SERIES_HPP
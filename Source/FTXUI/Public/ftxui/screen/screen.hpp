@@ -6,7 +6,9 @@
 
 #include "HAL/Platform.h"
 
+#include <cstddef>  // for size_t
 #include <cstdint>  // for uint8_t
+#include <limits>   // for numeric_limits
 #include <memory>
 #include <string>  // for string, basic_string, allocator
 #include <vector>  // for vector
@@ -51,6 +53,19 @@ struct FTXUI_API Pixel {
   // Colors:
   Color background_color = Color::Default;
   Color foreground_color = Color::Default;
+
+  // Flags identifying the style attributes above. They are combined into a
+  // mask to modify several attributes at once. See Screen::FillStyle.
+  enum Style : uint8_t {
+    Blink = 1 << 0,
+    Bold = 1 << 1,
+    Dim = 1 << 2,
+    Inverted = 1 << 3,
+    Underlined = 1 << 4,
+    UnderlinedDouble = 1 << 5,
+    Strikethrough = 1 << 6,
+    Automerge = 1 << 7,
+  };
 };
 
 /// @brief Define how the Screen's dimensions should look like.
@@ -77,6 +92,35 @@ class FTXUI_API Screen {
   Pixel& PixelAt(int x, int y);
   const Pixel& PixelAt(int x, int y) const;
 
+  // Bulk modifications of the cells in a rectangle. The rectangle is clipped
+  // against the stencil once, then every row is walked contiguously.
+  void FillStyle(const Box& box, uint8_t mask, uint8_t value);
+  void ToggleStyle(const Box& box, uint8_t mask);
+  void FillColor(const Box& box, Color color, bool background);
+  void FillHyperlink(const Box& box, uint8_t hyperlink);
+  void Fill(const Box& box, const Pixel& pixel);
+
+  // Write consecutive glyphs on row |y|, starting from column |x| and ending
+  // at most at column |x_max|. Newline glyphs are skipped.
+  void WriteRun(int x,
+                int y,
+                const std::vector<std::string>& glyphs,
+                int x_max = std::numeric_limits<int>::max());
+
+  // Call |fn(begin, end)| with the range of cells of every row of |box|,
+  // clipped against the stencil.
+  template <typename Fn>
+  void ForEachRow(const Box& box, Fn fn) {
+    const Box clipped = Box::Intersection(box, stencil);
+    if (clipped.x_min > clipped.x_max) {
+      return;
+    }
+    for (int y = clipped.y_min; y <= clipped.y_max; ++y) {
+      Pixel* row = pixels_.data() + size_t(y) * size_t(dimx_);
+      fn(row + clipped.x_min, row + clipped.x_max + 1);
+    }
+  }
+
   std::string ToString() const;
 
   // Print the Screen on to the terminal.
@@ -122,7 +166,7 @@ class FTXUI_API Screen {
  protected:
   int dimx_;
   int dimy_;
-  std::vector<std::vector<Pixel>> pixels_;
+  std::vector<Pixel> pixels_;  // Row-major, dimx_ * dimy_ cells.
   Cursor cursor_;
   std::vector<std::string> hyperlinks_ = {""};
 };
@@ -8,8 +8,9 @@
 
 #include <stddef.h>  // for size_t
 #include <cstdint>   // for uint8_t
-#include <string>    // for string, wstring, to_string
-#include <vector>    // for vector
+#include <string>       // for string, wstring, to_string
+#include <string_view>  // for string_view
+#include <vector>       // for vector
 
 namespace ftxui {
 FTXUI_API std::string to_string(const std::wstring& s);
@@ -20,11 +21,31 @@ std::wstring to_wstring(T s) {
   return to_wstring(std::to_string(s));
 }
 
-FTXUI_API int string_width(const std::string&);
+FTXUI_API int string_width(std::string_view);
+
+// The width and the number of glyphs of a string.
+struct TextMetrics {
+  int width = 0;
+  int glyphs = 0;
+};
+
+// Same as string_width and GlyphCount, memoized in a bounded per-thread cache
+// of the recently measured strings.
+FTXUI_API TextMetrics MeasureText(std::string_view input);
+
+// The counters of the MeasureText cache of the calling thread.
+struct TextMetricsStats {
+  size_t hits = 0;
+  size_t misses = 0;
+  size_t evictions = 0;
+  size_t inlined = 0;  // Short ASCII strings, measured without the cache.
+};
+FTXUI_API TextMetricsStats GetTextMetricsStats();
+FTXUI_API void ResetTextMetricsStats();
 
 // Split the string into a its glyphs. An empty one is inserted ater fullwidth
 // ones.
-FTXUI_API std::vector<std::string> Utf8ToGlyphs(const std::string& input);
+FTXUI_API std::vector<std::string> Utf8ToGlyphs(std::string_view input);
 
 // Map every cells drawn by |input| to their corresponding Glyphs. Half-size
 // Glyphs takes one cell, full-size Glyphs take two cells.
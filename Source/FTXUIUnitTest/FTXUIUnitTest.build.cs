@@ -5,6 +5,7 @@ public class FTXUIUnitTest : ModuleRules
 	public FTXUIUnitTest(ReadOnlyTargetRules Target) : base(Target)
 	{
         PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+        CppStandard = CppStandardVersion.Cpp20;
 
         PublicDependencyModuleNames.AddRange(new string[]
         {
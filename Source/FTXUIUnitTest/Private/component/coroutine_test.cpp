@@ -0,0 +1,121 @@
+// Copyright 2023 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <gtest/gtest.h>
+#include <chrono>  // for milliseconds
+#include <memory>  // for make_shared, shared_ptr
+#include <string>  // for string
+#include <vector>  // for vector
+
+#include "ftxui/component/component.hpp"           // for Renderer
+#include "ftxui/component/coroutine.hpp"           // for Coroutine
+#include "ftxui/component/event.hpp"               // for Event
+#include "ftxui/component/screen_interactive.hpp"  // for ScreenInteractive
+#include "ftxui/component/worker_pool.hpp"         // for Cancellation
+#include "ftxui/dom/elements.hpp"                  // for text
+
+// NOLINTBEGIN
+namespace ftxui {
+
+namespace {
+Coroutine Flow(ScreenInteractive& screen,
+               const int& frames,
+               std::vector<std::string>& log) {
+  log.push_back("start");
+  co_await screen.NextFrame();
+  log.push_back("frame " + std::to_string(frames));
+
+  const int value = co_await screen.RunAsync([] { return 42; });
+  log.push_back("async " + std::to_string(value));
+  co_await screen.RunAsync([] {});
+
+  co_await screen.Sleep(std::chrono::milliseconds(5));
+  log.push_back("sleep");
+
+  screen.PostEvent(Event::Character('a'));
+  screen.PostEvent(Event::Character('b'));
+  const Event event = co_await screen.NextEvent(
+      [](const Event& event) { return event == Event::Character('b'); });
+  log.push_back("event " + event.character());
+  screen.Exit();
+}
+
+Coroutine AwaitCancelled(ScreenInteractive& screen,
+                         CancellationToken token,
+                         std::shared_ptr<int> local,
+                         bool& resumed) {
+  co_await screen.RunAsync([] { return 1; }, token);
+  resumed = true;
+}
+}  // namespace
+
+TEST(CoroutineTest, Flow) {
+  auto screen = ScreenInteractive::FixedSize(2, 2);
+  std::vector<std::string> log;
+  std::vector<std::string> events;
+  int frames = 0;
+  auto component = Renderer([&] {
+    if (frames++ == 0) {
+      Flow(screen, frames, log);
+    }
+    return text("");
+  });
+  component = CatchEvent(component, [&](Event event) {
+    events.push_back(event.character());
+    return false;
+  });
+  screen.Loop(component);
+
+  EXPECT_EQ(log, std::vector<std::string>({
+                     "start",
+                     "frame 2",
+                     "async 42",
+                     "sleep",
+                     "event b",
+                 }));
+  // The events are given to the components as well.
+  EXPECT_EQ(events, std::vector<std::string>({"a", "b"}));
+}
+
+TEST(CoroutineTest, DestroyedWhenCancelled) {
+  auto screen = ScreenInteractive::FixedSize(2, 2);
+  auto local = std::make_shared<int>(0);
+  bool resumed = false;
+  bool started = false;
+  auto component = Renderer([&] {
+    if (!started) {
+      started = true;
+      Cancellation cancellation;
+      AwaitCancelled(screen, cancellation.Token(), local, resumed);
+      // The coroutine is destroyed once its continuation is dropped, which
+      // releases its locals.
+      screen.SetInterval(
+          [&] {
+            if (local.use_count() == 1) {
+              screen.Exit();
+            }
+          },
+          std::chrono::milliseconds(1));
+    }
+    return text("");
+  });
+  screen.Loop(component);
+  EXPECT_FALSE(resumed);
+  EXPECT_EQ(local.use_count(), 1);
+}
+
+TEST(CoroutineTest, FramePool) {
+  void* a = AllocateCoroutineFrame(100);
+  FreeCoroutineFrame(a, 100);
+  // Frames of similar sizes reuse the same blocks.
+  void* b = AllocateCoroutineFrame(120);
+  EXPECT_EQ(a, b);
+  FreeCoroutineFrame(b, 120);
+
+  void* large = AllocateCoroutineFrame(100000);
+  EXPECT_NE(large, nullptr);
+  FreeCoroutineFrame(large, 100000);
+}
+
+}  // namespace ftxui
+// NOLINTEND
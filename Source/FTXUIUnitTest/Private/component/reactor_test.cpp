@@ -0,0 +1,117 @@
+// Copyright 2023 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#if defined(__linux__)
+
+#include <gtest/gtest.h>
+#include <fcntl.h>   // for O_NONBLOCK
+#include <unistd.h>  // for pipe, pipe2, write, read, close
+#include <chrono>    // for milliseconds
+#include <csignal>   // for raise, SIGWINCH
+#include <thread>    // for thread, sleep_for
+#include <variant>   // for get, holds_alternative
+
+#include "ftxui/component/event.hpp"     // for Event
+#include "ftxui/component/reactor.hpp"   // for Reactor
+#include "ftxui/component/receiver.hpp"  // for MakeReceiver
+#include "ftxui/component/task.hpp"      // for Task, AnimationTask
+
+// NOLINTBEGIN
+namespace ftxui {
+
+namespace {
+int g_signal = 0;
+void OnSignal(int signal) {
+  g_signal = signal;
+}
+
+class ReactorTest : public testing::Test {
+ protected:
+  void SetUp() override { ASSERT_EQ(pipe(fds_), 0); }
+  void TearDown() override {
+    close(fds_[0]);
+    close(fds_[1]);
+  }
+  int fds_[2];
+};
+}  // namespace
+
+TEST_F(ReactorTest, Input) {
+  auto receiver = MakeReceiver<Task>(2);
+  Reactor reactor(fds_[0], receiver->MakeSender(0), receiver->MakeSender(1),
+                  &OnSignal);
+  EXPECT_EQ(write(fds_[1], "a\x1B", 2), 2);
+  EXPECT_FALSE(reactor.Block());
+
+  Task task;
+  EXPECT_TRUE(receiver->ReceiveNonBlocking(&task));
+  EXPECT_EQ(std::get<Event>(task), Event::Character('a'));
+  EXPECT_FALSE(receiver->ReceiveNonBlocking(&task));
+
+  // The escape key is flushed after a timeout, polled every 20ms.
+  for (int i = 0; i < 3 && !receiver->HasPending(); ++i) {
+    EXPECT_FALSE(reactor.Block());
+  }
+  EXPECT_TRUE(receiver->ReceiveNonBlocking(&task));
+  EXPECT_EQ(std::get<Event>(task), Event::Escape);
+}
+
+TEST_F(ReactorTest, Animation) {
+  auto receiver = MakeReceiver<Task>(2);
+  Reactor reactor(fds_[0], receiver->MakeSender(0), receiver->MakeSender(1),
+                  &OnSignal);
+  reactor.RequestAnimationFrame();
+  reactor.RequestAnimationFrame();
+  EXPECT_FALSE(reactor.Block());
+
+  Task task;
+  EXPECT_TRUE(receiver->ReceiveNonBlocking(&task, 1));
+  EXPECT_TRUE(std::holds_alternative<AnimationTask>(task));
+  EXPECT_FALSE(receiver->HasPending());
+}
+
+TEST_F(ReactorTest, Wakeup) {
+  auto receiver = MakeReceiver<Task>(2);
+  receiver->SetNotifier(&Reactor::WakeupActive);
+  Reactor reactor(fds_[0], receiver->MakeSender(0), receiver->MakeSender(1),
+                  &OnSignal);
+  auto sender = receiver->MakeSender(0);
+  std::thread thread([&] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    sender->Send(Event::Custom);
+  });
+  EXPECT_TRUE(receiver->Wait([&] { return reactor.Block(); }));
+  EXPECT_TRUE(receiver->HasPending());
+  thread.join();
+}
+
+TEST_F(ReactorTest, Signal) {
+  auto receiver = MakeReceiver<Task>(2);
+  Reactor reactor(fds_[0], receiver->MakeSender(0), receiver->MakeSender(1),
+                  &OnSignal);
+  g_signal = 0;
+  std::raise(SIGWINCH);
+  EXPECT_TRUE(reactor.Block());
+  EXPECT_EQ(g_signal, SIGWINCH);
+}
+
+TEST_F(ReactorTest, WakeupAfterDestruction) {
+  {
+    auto receiver = MakeReceiver<Task>(2);
+    Reactor reactor(fds_[0], receiver->MakeSender(0), receiver->MakeSender(1),
+                    &OnSignal);
+  }
+  // The file descriptors freed by the reactor are reused, but not written to.
+  int fds[2];
+  ASSERT_EQ(pipe2(fds, O_NONBLOCK), 0);
+  Reactor::WakeupActive();
+  char c = 0;
+  EXPECT_EQ(read(fds[0], &c, 1), -1);
+  close(fds[0]);
+  close(fds[1]);
+}
+
+}  // namespace ftxui
+// NOLINTEND
+
+#endif  // defined(__linux__)
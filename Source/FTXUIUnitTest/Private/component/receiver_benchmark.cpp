@@ -0,0 +1,53 @@
+// Copyright 2020 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <gtest/gtest.h>
+#include <chrono>   // for steady_clock, duration_cast, nanoseconds
+#include <string>   // for string, to_string
+#include <thread>   // for thread
+#include <utility>  // for move
+#include <vector>   // for vector
+
+#include "ftxui/component/receiver.hpp"  // for MakeReceiver, Sender
+
+// NOLINTBEGIN
+namespace ftxui {
+
+// Send 200k messages from 1 to 32 producer threads to a single consumer, and
+// report the average time per message.
+TEST(ReceiverBenchmark, Contention) {
+  const int messages = 200000;
+  for (int producers : {1, 2, 4, 8, 16, 32}) {
+    auto receiver = MakeReceiver<std::string>();
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+      threads.emplace_back(
+          [producers](Sender<std::string> sender) {
+            for (int i = 0; i < messages / producers; ++i) {
+              sender->Send("telemetry update");
+            }
+          },
+          receiver->MakeSender());
+    }
+
+    int received = 0;
+    std::string message;
+    while (receiver->Receive(&message)) {
+      ++received;
+    }
+    const auto end = std::chrono::steady_clock::now();
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    EXPECT_EQ(received, (messages / producers) * producers);
+    const auto elapsed =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
+    RecordProperty("nanoseconds_per_message_" + std::to_string(producers),
+                   std::to_string(elapsed.count() / received));
+  }
+}
+
+}  // namespace ftxui
+// NOLINTEND
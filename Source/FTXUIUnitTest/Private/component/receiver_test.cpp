@@ -1,9 +1,14 @@
 // Copyright 2020 Arthur Sonzogni. All rights reserved.
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
+#include <array>    // for array
+#include <atomic>   // for atomic
+#include <memory>   // for unique_ptr, make_unique
+#include <set>      // for set
 #include <string>   // for string
 #include <thread>   // for thread
 #include <utility>  // for move
+#include <vector>   // for vector
 
 #include "ftxui/component/receiver.hpp"
 #include "gtest/gtest.h"  // for AssertionResult, Message, Test, TestPartResult, EXPECT_EQ, EXPECT_TRUE, EXPECT_FALSE, TEST
@@ -78,5 +83,107 @@ TEST(Receiver, BasicWithThread) {
   t23.join();
 }
 
+TEST(Receiver, ManyProducers) {
+  auto receiver = MakeReceiver<int>();
+  std::vector<std::thread> threads;
+  for (int p = 0; p < 8; ++p) {
+    threads.emplace_back(
+        [p](Sender<int> sender) {
+          for (int i = 0; i < 1000; ++i) {
+            sender->Send(p * 1000 + i);
+          }
+        },
+        receiver->MakeSender());
+  }
+
+  // Every producer's values are received in order.
+  std::vector<int> last(8, -1);
+  int count = 0;
+  int value;
+  while (receiver->Receive(&value)) {
+    EXPECT_GT(value % 1000, last[value / 1000]);
+    last[value / 1000] = value % 1000;
+    ++count;
+  }
+  EXPECT_EQ(count, 8000);
+  EXPECT_TRUE(receiver->HasQuitted());
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+// Under contention, the received nodes are still reused instead of
+// allocating new ones.
+TEST(Receiver, NodesRecycledUnderContention) {
+  constexpr int kProducers = 4;
+  constexpr int kOutstanding = 8;
+  auto receiver = MakeReceiver<int>();
+  std::array<std::atomic<int>, kProducers> outstanding = {};
+  std::vector<std::thread> threads;
+  for (int p = 0; p < kProducers; ++p) {
+    threads.emplace_back(
+        [p, &outstanding](Sender<int> sender) {
+          for (int i = 0; i < 20000; ++i) {
+            while (outstanding[p] >= kOutstanding) {
+              std::this_thread::yield();
+            }
+            ++outstanding[p];
+            sender->Send(p);
+          }
+        },
+        receiver->MakeSender());
+  }
+
+  // The nodes are never freed, so each address is a distinct node.
+  std::set<const int*> nodes;
+  int value;
+  while (receiver->Wait()) {
+    nodes.insert(receiver->Peek(0));
+    receiver->ReceiveNonBlocking(&value);
+    --outstanding[value];
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  // The values in flight, and the nodes held by the consumer.
+  EXPECT_LE(nodes.size(), size_t(kProducers * (kOutstanding + 1) + 64 + 1));
+}
+
+TEST(Receiver, NonBlockingMoves) {
+  auto receiver = MakeReceiver<std::unique_ptr<int>>();
+  auto sender = receiver->MakeSender();
+  std::unique_ptr<int> value;
+  EXPECT_FALSE(receiver->ReceiveNonBlocking(&value));
+  sender->Send(std::make_unique<int>(42));
+  EXPECT_TRUE(receiver->HasPending());
+  EXPECT_TRUE(receiver->ReceiveNonBlocking(&value));
+  EXPECT_EQ(*value, 42);
+  EXPECT_FALSE(receiver->HasPending());
+  EXPECT_FALSE(receiver->HasQuitted());
+}
+
+TEST(Receiver, Lanes) {
+  auto receiver = MakeReceiver<char>(2);
+  auto background = receiver->MakeSender(1);
+  auto urgent = receiver->MakeSender(0);
+
+  background->Send('a');
+  background->Send('b');
+  urgent->Send('c');
+  background->Send('d', 0);
+  EXPECT_TRUE(receiver->HasPending(1));
+
+  char c;
+  EXPECT_TRUE(receiver->ReceiveNonBlocking(&c, 1));
+  EXPECT_EQ(c, 'a');
+  EXPECT_TRUE(receiver->Receive(&c));
+  EXPECT_EQ(c, 'c');
+  EXPECT_TRUE(receiver->Receive(&c));
+  EXPECT_EQ(c, 'd');
+  EXPECT_TRUE(receiver->Receive(&c));
+  EXPECT_EQ(c, 'b');
+  EXPECT_FALSE(receiver->HasPending());
+}
+
 }  // namespace ftxui
 // NOLINTEND
@@ -4,9 +4,15 @@
 #include <gtest/gtest.h>  // for Test, TestInfo (ptr only), TEST, EXPECT_EQ, Message, TestPartResult
 #include <csignal>  // for raise, SIGABRT, SIGFPE, SIGILL, SIGINT, SIGSEGV, SIGTERM
 #include <ftxui/component/event.hpp>  // for Event, Event::Custom
+#include <chrono>                     // for milliseconds, steady_clock
+#include <cstdint>                    // for uint64_t
+#include <functional>                 // for function
+#include <string>                     // for string
+#include <thread>                     // for thread, sleep_for
 #include <tuple>                      // for _Swallow_assign, ignore
+#include <vector>                     // for vector
 
-#include "ftxui/component/component.hpp"  // for Renderer
+#include "ftxui/component/component.hpp"  // for Renderer, CatchEvent
 #include "ftxui/component/screen_interactive.hpp"
 #include "ftxui/dom/elements.hpp"  // for text, Element
 
@@ -64,4 +70,264 @@ TEST(ScreenInteractive, PostTaskToNonActive) {
   screen.Post([] {});
 }
 
+// Events are handled before the closures posted earlier.
+TEST(ScreenInteractive, PostEventBeforeClosures) {
+  auto screen = ScreenInteractive::FixedSize(2, 2);
+  std::vector<int> order;
+  bool posted = false;
+  auto component = Renderer([&] {
+    if (!posted) {
+      posted = true;
+      for (int i = 0; i < 100; ++i) {
+        screen.Post([&] { order.push_back(0); });
+      }
+      screen.PostEvent(Event::Custom);
+      screen.Post(screen.ExitLoopClosure());
+    }
+    return text("");
+  });
+  component = CatchEvent(component, [&](Event event) {
+    if (event == Event::Custom) {
+      order.push_back(1);
+    }
+    return false;
+  });
+  screen.Loop(component);
+
+  ASSERT_EQ(order.size(), 101u);
+  EXPECT_EQ(order.front(), 1);
+}
+
+// Consecutive mouse motions and resizes are handled once. Repeated navigation
+// keys too, when enabled.
+TEST(ScreenInteractive, Coalescing) {
+  auto screen = ScreenInteractive::FixedSize(2, 2);
+  screen.CoalesceRepeatedKeys();
+  std::vector<Event> events;
+  bool posted = false;
+  auto component = Renderer([&] {
+    if (!posted) {
+      posted = true;
+      Mouse mouse;
+      mouse.button = Mouse::Left;
+      mouse.moved = true;
+      for (int i = 0; i < 50; ++i) {
+        mouse.x = i;
+        screen.PostEvent(Event::Mouse("", mouse));
+      }
+      mouse.button = Mouse::WheelDown;
+      mouse.moved = false;
+      screen.PostEvent(Event::Mouse("", mouse));
+      screen.PostEvent(Event::Mouse("", mouse));
+      for (int i = 0; i < 10; ++i) {
+        screen.PostEvent(Event::ArrowDown);
+      }
+      // Typed text is kept.
+      screen.PostEvent(Event::Character('l'));
+      screen.PostEvent(Event::Character('l'));
+      screen.PostEvent(Event::Backspace);
+      screen.PostEvent(Event::Backspace);
+      screen.PostEvent(Event::Custom);
+      screen.PostEvent(Event::Custom);
+      screen.Post(screen.ExitLoopClosure());
+    }
+    return text("");
+  });
+  component = CatchEvent(component, [&](Event event) {
+    events.push_back(event);
+    return false;
+  });
+  screen.Loop(component);
+
+  ASSERT_EQ(events.size(), 9u);
+  EXPECT_TRUE(events[0].is_mouse());
+  EXPECT_EQ(events[0].mouse().x, 49 - 1);  // Relative to the cursor.
+  EXPECT_EQ(events[1].mouse().button, Mouse::WheelDown);
+  EXPECT_EQ(events[2].mouse().button, Mouse::WheelDown);
+  EXPECT_EQ(events[3], Event::ArrowDown);
+  EXPECT_EQ(events[4], Event::Character('l'));
+  EXPECT_EQ(events[5], Event::Character('l'));
+  EXPECT_EQ(events[6], Event::Backspace);
+  EXPECT_EQ(events[7], Event::Backspace);
+  EXPECT_EQ(events[8], Event::Custom);
+}
+
+TEST(ScreenInteractive, Reactor) {
+  auto screen = ScreenInteractive::FixedSize(2, 2);
+  screen.UseReactor();
+  std::thread thread;
+  int frames = 0;
+  auto component = Renderer([&] {
+    if (frames++ == 0) {
+      thread = std::thread([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        screen.PostEvent(Event::Custom);
+        screen.Post(screen.ExitLoopClosure());
+      });
+    }
+    return text("");
+  });
+  screen.Loop(component);
+  thread.join();
+  EXPECT_EQ(frames, 2);
+}
+
+TEST(ScreenInteractive, FrameRate) {
+  auto screen = ScreenInteractive::FixedSize(2, 2);
+  screen.SetFrameRate(20);
+  std::thread thread;
+  int frames = 0;
+  int events = 0;
+  auto component = Renderer([&] {
+    if (frames++ == 0) {
+      thread = std::thread([&] {
+        // A storm of events during 200ms.
+        for (int i = 0; i < 200; ++i) {
+          screen.PostEvent(Event::Character('a'));
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        screen.Post(screen.ExitLoopClosure());
+      });
+    }
+    return text("");
+  });
+  component = CatchEvent(component, [&](Event) {
+    events++;
+    return false;
+  });
+  const auto start = std::chrono::steady_clock::now();
+  screen.Loop(component);
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  thread.join();
+  EXPECT_EQ(events, 200);
+  // At most one frame every 50ms, plus the first and the last one. The bound
+  // follows the measured duration, as the sleeps may last longer than asked.
+  const auto periods =
+      std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() /
+      50;
+  EXPECT_LE(frames, periods + 3);
+}
+
+TEST(ScreenInteractive, ModeReportIsConsumed) {
+  auto screen = ScreenInteractive::FixedSize(2, 2);
+  int events = 0;
+  bool posted = false;
+  auto component = Renderer([&] {
+    if (!posted) {
+      posted = true;
+      screen.PostEvent(Event::Special("\x1B[?2026;2$y"));
+      screen.Post(screen.ExitLoopClosure());
+    }
+    return text("");
+  });
+  component = CatchEvent(component, [&](Event) {
+    events++;
+    return false;
+  });
+  screen.Loop(component);
+  EXPECT_EQ(events, 0);
+}
+
+namespace {
+// Count the frames drawn when |post| is called after the first one.
+int CountFrames(ScreenInteractive& screen,
+                bool handled,
+                std::function<void()> post) {
+  int frames = 0;
+  auto component = Renderer([&] {
+    if (frames++ == 0) {
+      post();
+      screen.Post(screen.ExitLoopClosure());
+    }
+    return text("");
+  });
+  component = CatchEvent(component, [&](Event) { return handled; });
+  screen.Loop(component);
+  return frames;
+}
+}  // namespace
+
+TEST(ScreenInteractive, Invalidation) {
+  auto screen = ScreenInteractive::FixedSize(2, 2);
+  auto post_event = [&] { screen.PostEvent(Event::Character('a')); };
+  auto invalidate = [&] { screen.Post([&] { screen.Invalidate(); }); };
+
+  EXPECT_EQ(CountFrames(screen, false, post_event), 1);
+  EXPECT_EQ(CountFrames(screen, true, post_event), 2);
+  EXPECT_EQ(CountFrames(screen, false, [] {}), 1);
+  EXPECT_EQ(CountFrames(screen, false, invalidate), 2);
+  EXPECT_EQ(CountFrames(screen, false,
+                        [&] { screen.PostEvent(Event::Custom); }),
+            2);
+
+  screen.InvalidateOnEveryEvent();
+  EXPECT_EQ(CountFrames(screen, false, post_event), 2);
+}
+
+TEST(ScreenInteractive, Timers) {
+  for (const bool reactor : {false, true}) {
+    auto screen = ScreenInteractive::FixedSize(2, 2);
+    screen.UseReactor(reactor);
+    std::vector<std::string> log;
+    int ticks = 0;
+    uint64_t interval = 0;
+    bool started = false;
+    auto component = Renderer([&] {
+      if (!started) {
+        started = true;
+        const uint64_t cleared = screen.SetTimeout(
+            [&] { log.push_back("cleared"); }, std::chrono::milliseconds(10));
+        screen.ClearTimer(cleared);
+        interval = screen.SetInterval(
+            [&] {
+              log.push_back("interval");
+              if (++ticks == 3) {
+                screen.ClearTimer(interval);
+              }
+            },
+            std::chrono::milliseconds(20));
+        screen.SetTimeout([&] { log.push_back("timeout"); },
+                          std::chrono::milliseconds(30));
+        screen.SetTimeout(screen.ExitLoopClosure(),
+                          std::chrono::milliseconds(100));
+      }
+      return text("");
+    });
+    screen.Loop(component);
+    EXPECT_EQ(log, std::vector<std::string>(
+                       {"interval", "timeout", "interval", "interval"}));
+  }
+}
+
+TEST(ScreenInteractive, DebounceThrottle) {
+  auto screen = ScreenInteractive::FixedSize(2, 2);
+  screen.UseReactor();
+  int debounced = 0;
+  int throttled = 0;
+  bool started = false;
+  auto component = Renderer([&] {
+    if (!started) {
+      started = true;
+      auto debounce = screen.Debounce([&] { debounced++; },
+                                      std::chrono::milliseconds(30));
+      auto throttle = screen.Throttle([&] { throttled++; },
+                                      std::chrono::milliseconds(50));
+      for (int i = 0; i < 5; ++i) {
+        debounce();
+        throttle();
+      }
+      // Only the leading call ran so far.
+      EXPECT_EQ(debounced, 0);
+      EXPECT_EQ(throttled, 1);
+      screen.SetTimeout(screen.ExitLoopClosure(),
+                        std::chrono::milliseconds(150));
+    }
+    return text("");
+  });
+  screen.Loop(component);
+  EXPECT_EQ(debounced, 1);
+  // The leading call, and the trailing one merging the others.
+  EXPECT_EQ(throttled, 2);
+}
+
 }  // namespace ftxui
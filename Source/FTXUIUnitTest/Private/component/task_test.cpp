@@ -0,0 +1,131 @@
+// Copyright 2023 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <gtest/gtest.h>
+#include <array>    // for array
+#include <memory>   // for make_unique, make_shared, unique_ptr
+#include <set>      // for set
+#include <utility>  // for move
+#include <variant>  // for get, holds_alternative
+
+#include "ftxui/component/receiver.hpp"  // for MakeReceiver
+#include "ftxui/component/task.hpp"      // for ClosureTask, Task
+
+// NOLINTBEGIN
+namespace ftxui {
+
+namespace {
+// Record the address of the latest copy of the functor.
+struct Probe {
+  explicit Probe(const void** where) : where(where) { *where = this; }
+  Probe(Probe&& other) noexcept : where(other.where) { *where = this; }
+  void operator()() {}
+  const void** where;
+};
+
+template <class T>
+bool Contains(const T& object, const void* address) {
+  const auto* begin = reinterpret_cast<const char*>(&object);
+  const auto* pointer = static_cast<const char*>(address);
+  return pointer >= begin && pointer < begin + sizeof(T);
+}
+}  // namespace
+
+TEST(ClosureTask, MoveOnly) {
+  int value = 0;
+  auto pointer = std::make_unique<int>(42);
+  ClosureTask closure = [&value, pointer = std::move(pointer)] {
+    value = *pointer;
+  };
+  ClosureTask moved = std::move(closure);
+  EXPECT_FALSE(closure);
+  EXPECT_TRUE(moved);
+  moved();
+  EXPECT_EQ(value, 42);
+}
+
+TEST(ClosureTask, Large) {
+  std::array<int, 64> values = {};
+  values[63] = 42;
+  int value = 0;
+  ClosureTask closure = [&value, values] { value = values[63]; };
+  ClosureTask moved;
+  moved = std::move(closure);
+  moved();
+  EXPECT_EQ(value, 42);
+}
+
+TEST(ClosureTask, Destroyed) {
+  auto shared = std::make_shared<int>(0);
+  for (bool large : {false, true}) {
+    std::array<int, 64> padding = {};
+    {
+      ClosureTask closure;
+      if (large) {
+        closure = [shared, padding] {};
+      } else {
+        closure = [shared] {};
+      }
+      EXPECT_EQ(shared.use_count(), 2);
+      ClosureTask moved = std::move(closure);
+      EXPECT_EQ(shared.use_count(), 2);
+    }
+    EXPECT_EQ(shared.use_count(), 1);
+  }
+}
+
+TEST(ClosureTask, Empty) {
+  ClosureTask closure;
+  closure();
+  ClosureTask moved = [] {};
+  ClosureTask other = std::move(moved);
+  moved();
+  EXPECT_FALSE(moved);
+}
+
+TEST(ClosureTask, Inline) {
+  const void* where = nullptr;
+  ClosureTask closure = Probe(&where);
+  EXPECT_TRUE(Contains(closure, where));
+  ClosureTask moved = std::move(closure);
+  EXPECT_TRUE(Contains(moved, where));
+}
+
+TEST(ClosureTask, ThroughReceiver) {
+  auto receiver = MakeReceiver<Task>();
+  auto sender = receiver->MakeSender();
+  int value = 0;
+  for (int i = 1; i <= 3; ++i) {
+    auto pointer = std::make_unique<int>(i);
+    sender->Send([&value, pointer = std::move(pointer)] { value += *pointer; });
+    Task task;
+    EXPECT_TRUE(receiver->ReceiveNonBlocking(&task));
+    ASSERT_TRUE(std::holds_alternative<ClosureTask>(task));
+    std::get<ClosureTask>(task)();
+  }
+  EXPECT_EQ(value, 6);
+}
+
+// In the steady state, posting a task doesn't allocate: the closure is stored
+// inside the node of the receiver, and the received nodes are reused.
+TEST(ClosureTask, NodesRecycled) {
+  auto receiver = MakeReceiver<Task>();
+  auto sender = receiver->MakeSender();
+  std::set<const Task*> nodes;
+  for (int i = 0; i < 100; ++i) {
+    const void* where = nullptr;
+    sender->Send(ClosureTask(Probe(&where)));
+    const Task* pending = receiver->Peek(0);
+    ASSERT_NE(pending, nullptr);
+    EXPECT_TRUE(Contains(*pending, where));
+    nodes.insert(pending);
+    Task task;
+    EXPECT_TRUE(receiver->ReceiveNonBlocking(&task));
+    std::get<ClosureTask>(task)();
+  }
+  // The sentinel and the node being received alternate.
+  EXPECT_EQ(nodes.size(), 2u);
+}
+
+}  // namespace ftxui
+// NOLINTEND
@@ -103,6 +103,24 @@ TEST(Event, MouseLeftClickPressed) {
   EXPECT_FALSE(event_receiver->Receive(&received));
 }
 
+TEST(Event, MouseMoved) {
+  auto event_receiver = MakeReceiver<Task>();
+  {
+    auto parser = TerminalInputParser(event_receiver->MakeSender());
+    for (char c : std::string("\x1B[<32;12;42M\x1B[<0;12;42M")) {
+      parser.Add(c);
+    }
+  }
+
+  Task received;
+  EXPECT_TRUE(event_receiver->Receive(&received));
+  EXPECT_TRUE(std::get<Event>(received).mouse().moved);
+  EXPECT_EQ(Mouse::Left, std::get<Event>(received).mouse().button);
+  EXPECT_TRUE(event_receiver->Receive(&received));
+  EXPECT_FALSE(std::get<Event>(received).mouse().moved);
+  EXPECT_FALSE(event_receiver->Receive(&received));
+}
+
 TEST(Event, MouseLeftClickReleased) {
   auto event_receiver = MakeReceiver<Task>();
   {
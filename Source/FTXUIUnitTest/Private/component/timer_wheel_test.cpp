@@ -0,0 +1,232 @@
+// Copyright 2023 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <gtest/gtest.h>
+#include <chrono>   // for microseconds, milliseconds
+#include <random>   // for mt19937, uniform_int_distribution
+#include <vector>   // for vector
+
+#include "ftxui/component/timer_wheel.hpp"  // for TimerWheel
+
+// NOLINTBEGIN
+namespace ftxui {
+
+namespace {
+using std::chrono::microseconds;
+using std::chrono::milliseconds;
+const TimerWheel::Clock::time_point t0 = TimerWheel::Clock::now();
+}  // namespace
+
+TEST(TimerWheel, FireOnTime) {
+  TimerWheel wheel(t0);
+  const std::vector<int> delays = {1,    5,      63,      64,      65,
+                                   100,  4095,   4096,    5000,    300000,
+                                   16777215, 16777216, 20000000};
+  std::vector<int> fired(delays.size(), 0);
+  for (size_t i = 0; i < delays.size(); ++i) {
+    wheel.Add(t0 + milliseconds(delays[i]), [&, i] { fired[i]++; });
+  }
+  EXPECT_EQ(wheel.size(), delays.size());
+
+  for (size_t i = 0; i < delays.size(); ++i) {
+    wheel.Advance(t0 + milliseconds(delays[i] - 1));
+    EXPECT_EQ(fired[i], 0) << delays[i];
+    wheel.Advance(t0 + milliseconds(delays[i]));
+    EXPECT_EQ(fired[i], 1) << delays[i];
+  }
+  EXPECT_EQ(wheel.size(), 0u);
+}
+
+TEST(TimerWheel, NeverEarly) {
+  // Deadlines in between two ticks are rounded up.
+  TimerWheel wheel(t0);
+  std::mt19937 random(42);
+  std::uniform_int_distribution<int> delay(0, 20000);
+  std::vector<TimerWheel::Clock::time_point> deadlines;
+  std::vector<TimerWheel::Clock::time_point> fired;
+  TimerWheel::Clock::time_point now = t0;
+  for (int i = 0; i < 200; ++i) {
+    deadlines.push_back(t0 + microseconds(delay(random)));
+    fired.push_back({});
+    wheel.Add(deadlines.back(), [&, i] { fired[size_t(i)] = now; });
+  }
+  for (int step = 0; step <= 21000; step += 7) {
+    now = t0 + microseconds(step);
+    wheel.Advance(now);
+  }
+  for (size_t i = 0; i < deadlines.size(); ++i) {
+    EXPECT_GE(fired[i], deadlines[i]) << i;
+    // At most a tick late, plus the step of the loop.
+    EXPECT_LE(fired[i], deadlines[i] + milliseconds(1) + microseconds(7)) << i;
+  }
+}
+
+TEST(TimerWheel, Remove) {
+  TimerWheel wheel(t0);
+  int fired = 0;
+  const uint64_t a = wheel.Add(t0 + milliseconds(10), [&] { fired++; });
+  const uint64_t b = wheel.Add(t0 + milliseconds(10000), [&] { fired++; });
+  const uint64_t c = wheel.Add(t0 + milliseconds(20), [&] { fired++; });
+  EXPECT_NE(a, 0u);
+  EXPECT_TRUE(wheel.Remove(a));
+  EXPECT_FALSE(wheel.Remove(a));
+  EXPECT_TRUE(wheel.Remove(b));
+  EXPECT_EQ(wheel.size(), 1u);
+
+  wheel.Advance(t0 + milliseconds(100000));
+  EXPECT_EQ(fired, 1);
+  // Already run.
+  EXPECT_FALSE(wheel.Remove(c));
+  // The slots are reused with another id.
+  const uint64_t d = wheel.Add(t0 + milliseconds(100010), [&] { fired++; });
+  EXPECT_NE(d, a);
+  EXPECT_NE(d, c);
+  EXPECT_FALSE(wheel.Remove(a));
+  EXPECT_TRUE(wheel.Remove(d));
+}
+
+TEST(TimerWheel, Interval) {
+  TimerWheel wheel(t0);
+  int fired = 0;
+  uint64_t id = 0;
+  id = wheel.Add(
+      t0 + milliseconds(10),
+      [&] {
+        if (++fired == 5) {
+          wheel.Remove(id);
+        }
+      },
+      milliseconds(10));
+  for (int now = 5; now <= 35; now += 5) {
+    wheel.Advance(t0 + milliseconds(now));
+  }
+  EXPECT_EQ(fired, 3);
+  for (int now = 40; now <= 1000; now += 5) {
+    wheel.Advance(t0 + milliseconds(now));
+  }
+  EXPECT_EQ(fired, 5);
+  EXPECT_EQ(wheel.size(), 0u);
+}
+
+TEST(TimerWheel, IntervalSkipsMissedPeriods) {
+  TimerWheel wheel(t0);
+  int fired = 0;
+  wheel.Add(t0 + milliseconds(1000), [&] { fired++; }, milliseconds(1000));
+  wheel.Advance(t0 + milliseconds(1000));
+  EXPECT_EQ(fired, 1);
+
+  // The loop was stalled for 10 minutes. The timer runs once, and keeps its
+  // phase.
+  wheel.Advance(t0 + milliseconds(600500));
+  EXPECT_EQ(fired, 2);
+  wheel.Advance(t0 + milliseconds(600999));
+  EXPECT_EQ(fired, 2);
+  wheel.Advance(t0 + milliseconds(601000));
+  EXPECT_EQ(fired, 3);
+}
+
+TEST(TimerWheel, RemoveDueInTheSameTick) {
+  TimerWheel wheel(t0);
+  std::vector<int> order;
+  uint64_t a = 0;
+  uint64_t b = 0;
+  bool removed_a = false;
+  bool removed_b = false;
+  a = wheel.Add(t0 + milliseconds(10), [&] {
+    order.push_back(1);
+    removed_b = wheel.Remove(b);
+  });
+  b = wheel.Add(t0 + milliseconds(10), [&] {
+    order.push_back(2);
+    removed_a = wheel.Remove(a);
+  });
+  wheel.Advance(t0 + milliseconds(10));
+  // Whichever runs first cancels the other one.
+  ASSERT_EQ(order.size(), 1u);
+  EXPECT_EQ(order[0] == 1 ? removed_b : removed_a, true);
+  EXPECT_EQ(wheel.size(), 0u);
+  EXPECT_FALSE(wheel.Remove(a));
+  EXPECT_FALSE(wheel.Remove(b));
+
+  // A periodic timer can be cancelled as well.
+  int fired = 0;
+  uint64_t periodic = 0;
+  wheel.Add(t0 + milliseconds(20),
+            [&] { EXPECT_TRUE(wheel.Remove(periodic)); });
+  periodic =
+      wheel.Add(t0 + milliseconds(20), [&] { fired++; }, milliseconds(10));
+  for (int now = 20; now <= 100; now += 10) {
+    wheel.Advance(t0 + milliseconds(now));
+  }
+  EXPECT_LE(fired, 1);
+  EXPECT_EQ(wheel.size(), 0u);
+}
+
+TEST(TimerWheel, AddFromCallback) {
+  TimerWheel wheel(t0);
+  std::vector<int> order;
+  wheel.Add(t0 + milliseconds(10), [&] {
+    order.push_back(1);
+    // Already due, it runs on the next tick.
+    wheel.Add(t0, [&] { order.push_back(2); });
+    wheel.Add(t0 + milliseconds(12), [&] { order.push_back(3); });
+  });
+  wheel.Advance(t0 + milliseconds(10));
+  EXPECT_EQ(order, std::vector<int>({1}));
+  wheel.Advance(t0 + milliseconds(100));
+  EXPECT_EQ(order, std::vector<int>({1, 2, 3}));
+}
+
+TEST(TimerWheel, NextDeadline) {
+  TimerWheel wheel(t0);
+  EXPECT_FALSE(wheel.NextDeadline());
+
+  const uint64_t id = wheel.Add(t0 + milliseconds(5000), [] {});
+  // A lower bound, until the timer reaches the first level.
+  auto next = wheel.NextDeadline();
+  ASSERT_TRUE(next);
+  EXPECT_GT(*next, t0);
+  EXPECT_LE(*next, t0 + milliseconds(5000));
+
+  wheel.Add(t0 + milliseconds(5), [] {});
+  EXPECT_EQ(wheel.NextDeadline(), t0 + milliseconds(5));
+  wheel.Advance(t0 + milliseconds(5));
+
+  // Following the deadlines reaches the timer in a few steps.
+  int steps = 0;
+  while (wheel.size()) {
+    next = wheel.NextDeadline();
+    ASSERT_TRUE(next);
+    ASSERT_LE(*next, t0 + milliseconds(5000));
+    wheel.Advance(*next);
+    ++steps;
+  }
+  EXPECT_LE(steps, 3);
+  EXPECT_FALSE(wheel.Remove(id));
+  EXPECT_FALSE(wheel.NextDeadline());
+}
+
+TEST(TimerWheel, Many) {
+  TimerWheel wheel(t0);
+  std::mt19937 random(42);
+  std::uniform_int_distribution<int> delay(1, 1000000);
+  int now = 0;
+  int fired = 0;
+  int early = 0;
+  for (int i = 0; i < 10000; ++i) {
+    const int deadline = delay(random);
+    wheel.Add(t0 + milliseconds(deadline), [&, deadline] {
+      fired++;
+      early += deadline > now;
+    });
+  }
+  while (wheel.size()) {
+    now += 997;
+    wheel.Advance(t0 + milliseconds(now));
+  }
+  EXPECT_EQ(fired, 10000);
+  EXPECT_EQ(early, 0);
+}
+
+}  // namespace ftxui
+// NOLINTEND
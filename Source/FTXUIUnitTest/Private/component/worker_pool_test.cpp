@@ -0,0 +1,214 @@
+// Copyright 2023 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <gtest/gtest.h>
+#include <algorithm>  // for is_sorted
+#include <atomic>     // for atomic
+#include <chrono>     // for milliseconds
+#include <memory>     // for make_shared
+#include <mutex>      // for mutex, lock_guard
+#include <thread>     // for sleep_for, yield
+#include <utility>    // for move
+#include <vector>     // for vector
+
+#include "ftxui/component/component.hpp"           // for Renderer
+#include "ftxui/component/screen_interactive.hpp"  // for ScreenInteractive
+#include "ftxui/component/worker_pool.hpp"  // for WorkerPool, Cancellation
+#include "ftxui/dom/elements.hpp"           // for text
+
+// NOLINTBEGIN
+namespace ftxui {
+
+namespace {
+// Collect the continuations, instead of posting them to a main loop.
+class Posted {
+ public:
+  std::function<void(ClosureTask)> Post() {
+    return [this](ClosureTask task) {
+      const std::lock_guard<std::mutex> lock(mutex_);
+      tasks_.push_back(std::move(task));
+    };
+  }
+
+  // Wait for |count| continuations.
+  void Wait(size_t count) {
+    while (true) {
+      {
+        const std::lock_guard<std::mutex> lock(mutex_);
+        if (tasks_.size() >= count) {
+          return;
+        }
+      }
+      std::this_thread::yield();
+    }
+  }
+
+  // Wait for |count| continuations and run them.
+  void Run(size_t count) {
+    Wait(count);
+    const std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& task : tasks_) {
+      task();
+    }
+    tasks_.clear();
+  }
+
+ private:
+  std::mutex mutex_;
+  std::vector<ClosureTask> tasks_;
+};
+}  // namespace
+
+TEST(WorkerPoolTest, Then) {
+  Posted posted;
+  WorkerPool pool(posted.Post(), 2);
+  EXPECT_EQ(pool.workers(), 2u);
+
+  int result = 0;
+  pool.Run([] { return 42; }).Then([&](int value) { result = value; });
+  bool done = false;
+  pool.Run([] {}).Then([&] { done = true; });
+  posted.Run(2);
+  EXPECT_EQ(result, 42);
+  EXPECT_TRUE(done);
+}
+
+TEST(WorkerPoolTest, Many) {
+  Posted posted;
+  WorkerPool pool(posted.Post(), 4);
+  std::atomic<int> sum = 0;
+  int continuations = 0;
+  for (int i = 0; i < 1000; ++i) {
+    pool.Run([&sum, i] {
+          sum += i;
+          return i;
+        })
+        .Then([&](int) { continuations++; });
+  }
+  posted.Run(1000);
+  EXPECT_EQ(sum, 999 * 1000 / 2);
+  EXPECT_EQ(continuations, 1000);
+}
+
+TEST(WorkerPoolTest, Nested) {
+  Posted posted;
+  WorkerPool pool(posted.Post(), 2);
+  int result = 0;
+  pool.Run([&] {
+    pool.Run([] { return 2; }).Then([&](int value) { result += value; });
+    return 1;
+  }).Then([&](int value) { result += value; });
+  posted.Run(2);
+  EXPECT_EQ(result, 3);
+}
+
+TEST(WorkerPoolTest, Cancellation) {
+  Posted posted;
+  WorkerPool pool(posted.Post(), 1);
+  bool called = false;
+  {
+    Cancellation cancellation;
+    pool.Run([] { return 1; }, cancellation.Token()).Then([&](int) {
+      called = true;
+    });
+    posted.Run(1);
+    EXPECT_TRUE(called);
+
+    called = false;
+    pool.Run([] { return 1; }, cancellation.Token()).Then([&](int) {
+      called = true;
+    });
+    posted.Wait(1);
+  }
+  // The continuation was posted, but is cancelled before running.
+  posted.Run(1);
+  EXPECT_FALSE(called);
+}
+
+TEST(WorkerPoolTest, CancelledBeforeStarting) {
+  Posted posted;
+  WorkerPool pool(posted.Post(), 1);
+  std::atomic<bool> release = false;
+  pool.Run([&] {
+    while (!release) {
+      std::this_thread::yield();
+    }
+  });
+
+  auto captured = std::make_shared<int>(0);
+  {
+    Cancellation cancellation;
+    pool.Run([] { return 1; }, cancellation.Token())
+        .Then([captured](int) { FAIL(); });
+  }
+  EXPECT_EQ(captured.use_count(), 2);
+  release = true;
+
+  // The continuation is dropped on the main loop, without running.
+  posted.Wait(1);
+  EXPECT_EQ(captured.use_count(), 2);
+  posted.Run(1);
+  EXPECT_EQ(captured.use_count(), 1);
+}
+
+TEST(WorkerPoolTest, ScreenInteractive) {
+  auto screen = ScreenInteractive::FixedSize(2, 2);
+  screen.SetWorkerCount(2);
+  std::vector<int> rows;
+  bool started = false;
+  auto component = Renderer([&] {
+    if (!started) {
+      started = true;
+      std::vector<int> unsorted;
+      for (int i = 0; i < 1000; ++i) {
+        unsorted.push_back((i * 7919) % 1000);
+      }
+      screen
+          .RunAsync([unsorted = std::move(unsorted)]() mutable {
+            std::sort(unsorted.begin(), unsorted.end());
+            return unsorted;
+          })
+          .Then([&](std::vector<int> sorted) { rows = std::move(sorted); });
+    }
+    // The continuation redraws the screen.
+    if (!rows.empty()) {
+      screen.Exit();
+    }
+    return text("");
+  });
+  screen.Loop(component);
+  EXPECT_EQ(rows.size(), 1000u);
+  EXPECT_TRUE(std::is_sorted(rows.begin(), rows.end()));
+}
+
+TEST(WorkerPoolTest, ContinuationsOutsideOfTheLoop) {
+  auto screen = ScreenInteractive::FixedSize(2, 2);
+  screen.SetWorkerCount(1);
+  int result = 0;
+  // Posted before the loop starts, the continuation waits for it.
+  screen.RunAsync([] { return 1; }).Then([&](int value) { result += value; });
+  WorkerPool* pool = &screen.Workers();
+
+  int expected = 1;
+  auto component = Renderer([&] {
+    if (result == expected) {
+      screen.Exit();
+    }
+    return text("");
+  });
+  screen.Loop(component);
+  EXPECT_EQ(result, 1);
+
+  // The pool is kept in between loops. This continuation is attached after
+  // the function completed, while the loop isn't running.
+  auto async = screen.RunAsync([] { return 2; });
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  async.Then([&](int value) { result += value; });
+  expected = 3;
+  screen.Loop(component);
+  EXPECT_EQ(result, 3);
+  EXPECT_EQ(&screen.Workers(), pool);
+}
+
+}  // namespace ftxui
+// NOLINTEND
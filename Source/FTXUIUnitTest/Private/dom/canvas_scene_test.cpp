@@ -0,0 +1,93 @@
+// Copyright 2021 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <gtest/gtest.h>
+#include <limits>  // for numeric_limits
+
+#include "ftxui/dom/canvas.hpp"        // for Canvas
+#include "ftxui/dom/canvas_scene.hpp"  // for CanvasScene
+#include "ftxui/screen/color.hpp"      // for Color
+
+// NOLINTBEGIN
+namespace ftxui {
+
+TEST(CanvasSceneTest, Point) {
+  CanvasScene scene;
+  scene.AddPoint(0.0, 1.0, Color::Red);
+  scene.AddPoint(1.0, 0.0);
+  scene.AddPoint(2.0, 0.0);  // Outside of the view.
+  scene.SetView(0.0, 1.0, 0.0, 1.0);
+
+  Canvas c(4, 8);
+  EXPECT_EQ(scene.Draw(c), 3u);
+  EXPECT_EQ(c.GetPixel(0, 0).character, "⠁");
+  EXPECT_EQ(c.GetPixel(0, 0).foreground_color, Color(Color::Red));
+  EXPECT_EQ(c.GetPixel(1, 1).character, "⢀");
+}
+
+TEST(CanvasSceneTest, ClippedLine) {
+  CanvasScene scene;
+  scene.AddLine(-100.0, 0.0, 100.0, 0.0);
+  scene.SetView(0.0, 7.0, -1.0, 1.0);
+
+  Canvas c(8, 4);
+  scene.Draw(c);
+  for (int x = 0; x < 4; ++x) {
+    EXPECT_EQ(c.GetPixel(x, 0).character, "⠤");
+  }
+}
+
+TEST(CanvasSceneTest, PanZoom) {
+  CanvasScene scene;
+  scene.SetView(0.0, 10.0, 0.0, 10.0);
+  scene.Zoom(2.0, 5.0, 5.0);
+  EXPECT_EQ(scene.view_x_min(), 2.5);
+  EXPECT_EQ(scene.view_x_max(), 7.5);
+  scene.Pan(1.0, -1.0);
+  EXPECT_EQ(scene.view_x_min(), 3.5);
+  EXPECT_EQ(scene.view_y_max(), 6.5);
+}
+
+TEST(CanvasSceneTest, NonFinite) {
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  const double inf = std::numeric_limits<double>::infinity();
+  const double max = std::numeric_limits<double>::max();
+  CanvasScene scene;
+  scene.AddPoint(nan, 0.0);
+  scene.AddLine(0.0, 0.0, inf, 0.0);
+  EXPECT_EQ(scene.size(), 0u);
+
+  // The bounds of these overflow.
+  scene.AddPoint(-max, -max);
+  scene.AddPoint(max, max);
+  scene.AddPoint(0.0, 1.0);
+  scene.SetView(0.0, 1.0, 0.0, 1.0);
+  Canvas c(4, 8);
+  scene.Draw(c);
+  EXPECT_EQ(c.GetPixel(0, 0).character, "⠁");
+
+  scene.SetView(nan, 1.0, 0.0, 1.0);
+  EXPECT_EQ(scene.Draw(c), 0u);
+}
+
+TEST(CanvasSceneTest, OnlyVisitPrimitivesInView) {
+  CanvasScene scene;
+  for (int y = 0; y < 300; ++y) {
+    for (int x = 0; x < 300; ++x) {
+      scene.AddPoint(x, y);
+    }
+  }
+  scene.AddLine(0.0, 0.0, 300.0, 300.0);
+
+  Canvas c(100, 100);
+  scene.SetView(0.0, 300.0, 0.0, 300.0);
+  EXPECT_EQ(scene.Draw(c), scene.size());
+
+  scene.SetView(100.0, 110.0, 100.0, 110.0);
+  const size_t visited = scene.Draw(c);
+  EXPECT_GE(visited, 121u);
+  EXPECT_LT(visited, 1000u);
+}
+
+}  // namespace ftxui
+// NOLINTEND
@@ -2,12 +2,18 @@
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
 #include <gtest/gtest.h>
-#include <cstdint>  // for uint32_t
-#include <string>   // for allocator, string
+#include <algorithm>  // for max
+#include <climits>    // for INT_MAX, INT_MIN
+#include <cstdint>    // for uint32_t
+#include <cstdlib>    // for abs
+#include <random>     // for mt19937, uniform_int_distribution
+#include <string>     // for allocator, string
+#include <vector>     // for vector
 
 #include "ftxui/dom/canvas.hpp"    // for Canvas
-#include "ftxui/dom/elements.hpp"  // for canvas
+#include "ftxui/dom/elements.hpp"  // for canvas, hbox
 #include "ftxui/dom/node.hpp"      // for Render
+#include "ftxui/screen/box.hpp"    // for Box
 #include "ftxui/screen/color.hpp"  // for Color, Color::Black, Color::Blue, Color::Red, Color::White, Color::Yellow, Color::Cyan, Color::Green
 #include "ftxui/screen/screen.hpp"    // for Screen
 #include "ftxui/screen/terminal.hpp"  // for SetColorSupport, Color, TrueColor
@@ -104,5 +110,215 @@ TEST(CanvasTest, GoldText) {
   EXPECT_EQ(Hash(screen.ToString()), 1074960375);
 }
 
+TEST(CanvasTest, BlockOffAndToggleMatchOn) {
+  Canvas c(2, 4);
+  c.DrawBlockOn(0, 0);
+  c.DrawBlockOn(1, 2);
+  EXPECT_EQ(c.GetPixel(0, 0).character, "▚");
+  c.DrawBlockToggle(1, 2);
+  EXPECT_EQ(c.GetPixel(0, 0).character, "▘");
+  c.DrawBlockOff(0, 0);
+  EXPECT_EQ(c.GetPixel(0, 0).character, " ");
+}
+
+TEST(CanvasTest, ManyStyles) {
+  Canvas c(4, 4);
+  for (int i = 0; i < 5000; ++i) {
+    c.DrawPoint(0, 0, true, Color::RGB(i % 256, i / 256, 0));
+  }
+  c.DrawText(2, 0, "a", Color::Red);
+  EXPECT_EQ(c.GetPixel(0, 0).character, "⠁");
+  EXPECT_EQ(c.GetPixel(0, 0).foreground_color, Color::RGB(4999 % 256, 19, 0));
+  EXPECT_EQ(c.GetPixel(1, 0).character, "a");
+  EXPECT_EQ(c.GetPixel(1, 0).foreground_color, Color(Color::Red));
+  EXPECT_EQ(c.GetPixel(5, 5).character, " ");
+}
+
+TEST(CanvasTest, BatchedMatchesSingle) {
+  Canvas batched(40, 40);
+  Canvas single(40, 40);
+  const std::vector<Canvas::Point> points = {
+      {1, 1}, {5, 7}, {-1, 3}, {39, 39}, {40, 0}};
+  const std::vector<Canvas::Point> polyline = {{0, 0}, {30, 10}, {12, 35}};
+  const std::vector<Canvas::Point> segments = {
+      {3, 30}, {20, 30}, {0, 39}, {39, 0}, {7, 7}};
+  const int ys[] = {5, 6, 7, 8, 9};
+  batched.DrawPoints(points, Color::Red);
+  batched.DrawPolyline(polyline, Color::Blue);
+  batched.DrawSegments(segments);
+  batched.DrawScatter(-2, ys);
+
+  single.DrawPoint(1, 1, true, Color::Red);
+  single.DrawPoint(5, 7, true, Color::Red);
+  single.DrawPoint(39, 39, true, Color::Red);
+  single.DrawPointLine(0, 0, 30, 10, Color::Blue);
+  single.DrawPointLine(30, 10, 12, 35, Color::Blue);
+  single.DrawPointLine(3, 30, 20, 30);
+  single.DrawPointLine(0, 39, 39, 0);
+  single.DrawPoint(0, 7, true);
+  single.DrawPoint(1, 8, true);
+  single.DrawPoint(2, 9, true);
+
+  for (int y = 0; y < 10; ++y) {
+    for (int x = 0; x < 20; ++x) {
+      EXPECT_EQ(batched.GetPixel(x, y).character,
+                single.GetPixel(x, y).character);
+      EXPECT_EQ(batched.GetPixel(x, y).foreground_color,
+                single.GetPixel(x, y).foreground_color);
+    }
+  }
+}
+
+TEST(CanvasTest, LineClipping) {
+  // Clipping the lines to the canvas doesn't change the dots drawn.
+  std::mt19937 random(42);
+  std::uniform_int_distribution<int> coordinate(-60, 80);
+  for (int i = 0; i < 200; ++i) {
+    const Canvas::Point a = {coordinate(random), coordinate(random)};
+    const Canvas::Point b = {coordinate(random), coordinate(random)};
+    Canvas clipped(20, 20);
+    const std::vector<Canvas::Point> segment = {a, b};
+    clipped.DrawSegments(segment);
+
+    // The same walk, drawing every dot.
+    Canvas reference(20, 20);
+    const int dx = std::abs(b.x - a.x);
+    const int dy = std::abs(b.y - a.y);
+    const int sx = a.x < b.x ? 1 : -1;
+    const int sy = a.y < b.y ? 1 : -1;
+    int x = a.x;
+    int y = a.y;
+    int error = dx - dy;
+    for (int step = 0; step < std::max(dx, dy); ++step) {
+      reference.DrawPointOn(x, y);
+      if (2 * error >= -dy) {
+        error -= dy;
+        x += sx;
+      }
+      if (2 * error <= dx) {
+        error += dx;
+        y += sy;
+      }
+    }
+    reference.DrawPointOn(b.x, b.y);
+
+    for (int cy = 0; cy < 5; ++cy) {
+      for (int cx = 0; cx < 10; ++cx) {
+        ASSERT_EQ(clipped.GetPixel(cx, cy).character,
+                  reference.GetPixel(cx, cy).character)
+            << a.x << "," << a.y << " " << b.x << "," << b.y;
+      }
+    }
+  }
+
+  // Far away end points are not walked one dot at a time.
+  Canvas far(20, 20);
+  const std::vector<Canvas::Point> segments = {
+      {-1000000000, 0}, {10, 0}, {INT_MIN, INT_MIN}, {INT_MAX, INT_MAX}};
+  far.DrawSegments(segments);
+  Canvas near(20, 20);
+  near.DrawPointLine(0, 0, 10, 0);
+  near.DrawPointLine(0, 0, 19, 19);
+  for (int cy = 0; cy < 5; ++cy) {
+    for (int cx = 0; cx < 10; ++cx) {
+      EXPECT_EQ(far.GetPixel(cx, cy).character,
+                near.GetPixel(cx, cy).character);
+    }
+  }
+}
+
+TEST(CanvasTest, BatchedStyleOncePerStyle) {
+  Canvas c(100, 100);
+  std::vector<Canvas::Point> points;
+  for (int i = 0; i < 100; ++i) {
+    points.push_back({i, i});
+  }
+  int calls = 0;
+  c.DrawPolyline(points, [&](Pixel& p) {
+    ++calls;
+    p.bold = true;
+  });
+  EXPECT_EQ(calls, 1);
+  EXPECT_TRUE(c.GetPixel(10, 5).bold);
+  EXPECT_EQ(c.GetPixel(10, 5).character, "⠑");
+}
+
+TEST(CanvasTest, Retained) {
+  Canvas c(20, 20);
+  c.DrawPointCircle(10, 10, 5, Color::Red);
+  c.DrawText(0, 0, "hi");
+  EXPECT_EQ(c.dirty(), (Box{0, 7, 0, 3}));
+
+  auto draw = [&](Element element) {
+    Screen screen(12, 6);
+    Render(screen, element);
+    return screen.ToString();
+  };
+  EXPECT_EQ(draw(canvasRetained(&c)), draw(canvas(&c)));
+  EXPECT_TRUE(c.dirty().IsEmpty());
+
+  c.DrawPointLine(0, 19, 19, 19, Color::Blue);
+  EXPECT_EQ(c.dirty(), (Box{0, 9, 4, 4}));
+  EXPECT_EQ(draw(canvasRetained(&c)), draw(canvas(&c)));
+
+  c.Clear();
+  EXPECT_EQ(draw(canvasRetained(&c)), draw(canvas(Canvas(20, 20))));
+}
+
+TEST(CanvasTest, DrawingFunctionReused) {
+  // The canvases of a previous frame are reused, cleared. Two sizes are
+  // kept.
+  auto draw = [](bool on) {
+    auto fn = [on](Canvas& c) {
+      EXPECT_EQ(c.GetPixel(0, 0).character, " ");
+      if (on) {
+        c.DrawPointOn(0, 0);
+        c.DrawText(2, 4, "a", Color::Red);
+      }
+    };
+    Screen screen(6, 2);
+    Render(screen, hbox({canvas(4, 8, fn), canvas(8, 8, fn)}));
+    return screen.ToString();
+  };
+  const std::string empty = draw(false);
+  EXPECT_NE(draw(true), empty);
+  EXPECT_EQ(draw(false), empty);
+}
+
+TEST(CanvasTest, PolygonFilled) {
+  Canvas c(10, 8);
+  c.DrawPointPolygonFilled({{0, 0}, {9, 0}, {9, 7}, {0, 7}});
+  for (int y = 0; y < 2; ++y) {
+    for (int x = 0; x < 5; ++x) {
+      EXPECT_EQ(c.GetPixel(x, y).character, "⣿");
+    }
+  }
+
+  // A concave polygon: the notch stays empty.
+  Canvas notch(12, 12);
+  notch.DrawBlockPolygonFilled(
+      {{0, 0}, {11, 0}, {11, 11}, {8, 11}, {8, 4}, {3, 4}, {3, 11}, {0, 11}});
+  EXPECT_EQ(notch.GetPixel(0, 0).character, "█");
+  EXPECT_EQ(notch.GetPixel(5, 0).character, "█");
+  EXPECT_EQ(notch.GetPixel(0, 2).character, "█");
+  EXPECT_EQ(notch.GetPixel(2, 2).character, " ");
+  EXPECT_EQ(notch.GetPixel(5, 2).character, "█");
+}
+
+TEST(CanvasTest, TriangleFilled) {
+  Canvas c(8, 8);
+  int calls = 0;
+  c.DrawPointTriangleFilled({0, 0}, {7, 0}, {0, 7}, [&](Pixel& p) {
+    ++calls;
+    p.foreground_color = Color::Red;
+  });
+  EXPECT_EQ(calls, 1);
+  EXPECT_EQ(c.GetPixel(0, 0).character, "⣿");
+  EXPECT_EQ(c.GetPixel(0, 0).foreground_color, Color(Color::Red));
+  EXPECT_EQ(c.GetPixel(3, 0).character, "⠋");
+  EXPECT_EQ(c.GetPixel(1, 1).character, "⠋");
+  EXPECT_EQ(c.GetPixel(3, 1).character, " ");
+}
+
 }  // namespace ftxui
 // NOLINTEND
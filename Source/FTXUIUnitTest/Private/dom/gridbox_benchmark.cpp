@@ -0,0 +1,57 @@
+// Copyright 2020 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <gtest/gtest.h>
+#include <chrono>  // for steady_clock, duration_cast, microseconds
+#include <string>  // for string, to_string
+#include <vector>  // for vector
+
+#include "ftxui/dom/elements.hpp"  // for text, gridbox, Element, Elements
+#include "ftxui/dom/node.hpp"      // for Render
+#include "ftxui/screen/screen.hpp"  // for Screen
+
+// NOLINTBEGIN
+namespace ftxui {
+
+namespace {
+Element Grid(int width, int height) {
+  std::vector<Elements> lines;
+  lines.reserve(height);
+  for (int y = 0; y < height; ++y) {
+    Elements line;
+    line.reserve(width);
+    for (int x = 0; x < width; ++x) {
+      line.push_back(text(std::to_string((x + y) % 10)));
+    }
+    lines.push_back(std::move(line));
+  }
+  return gridbox(std::move(lines));
+}
+}  // namespace
+
+// Render a 100x1000 cells gridbox several times and report the average time
+// per frame.
+TEST(GridboxBenchmark, Grid100x1000) {
+  const int width = 100;
+  const int height = 1000;
+  const int iterations = 10;
+  auto document = Grid(width, height);
+  Screen screen(width, height);
+
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    Render(screen, document);
+  }
+  const auto end = std::chrono::steady_clock::now();
+  const auto elapsed =
+      std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+  RecordProperty("microseconds_per_frame",
+                 std::to_string(elapsed.count() / iterations));
+
+  EXPECT_EQ(screen.at(0, 0), "0");
+  EXPECT_EQ(screen.at(width - 1, 0), "9");
+  EXPECT_EQ(screen.at(3, height - 1), "2");
+}
+
+}  // namespace ftxui
+// NOLINTEND
@@ -0,0 +1,84 @@
+// Copyright 2020 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <gtest/gtest.h>
+#include <limits>  // for numeric_limits
+#include <vector>  // for vector
+
+#include "ftxui/dom/elements.hpp"  // for heatmap
+#include "ftxui/dom/node.hpp"      // for Render
+#include "ftxui/screen/color.hpp"  // for Color
+#include "ftxui/screen/screen.hpp"  // for Screen
+
+// NOLINTBEGIN
+namespace ftxui {
+
+TEST(HeatmapTest, TwoRowsPerCell) {
+  // 3 columns, 3 rows.
+  std::vector<float> values = {
+      0.f, 1.f, 2.f,  //
+      2.f, 1.f, 0.f,  //
+      1.f, 1.f, 1.f,  //
+  };
+  auto element = heatmap(values, 3, 3, Color::Black, Color::White);
+  const Color low = Color::Interpolate(0.f, Color::Black, Color::White);
+  const Color high = Color::Interpolate(1.f, Color::Black, Color::White);
+  Screen screen(5, 3);
+  Render(screen, element);
+
+  EXPECT_EQ(screen.PixelAt(0, 0).character, "▀");
+  EXPECT_EQ(screen.PixelAt(0, 0).foreground_color, low);
+  EXPECT_EQ(screen.PixelAt(0, 0).background_color, high);
+  EXPECT_EQ(screen.PixelAt(2, 0).foreground_color, high);
+  EXPECT_EQ(screen.PixelAt(2, 0).background_color, low);
+  EXPECT_EQ(screen.PixelAt(1, 1).character, "▀");
+  EXPECT_EQ(screen.PixelAt(1, 1).background_color, Color());
+  EXPECT_EQ(screen.PixelAt(3, 0).character, " ");
+  EXPECT_EQ(screen.PixelAt(0, 2).character, " ");
+}
+
+TEST(HeatmapTest, Colormap) {
+  int calls = 0;
+  const float values[] = {0.f, 1.f};
+  auto element = heatmap(values, 2, 1, [&](float t) {
+    ++calls;
+    return t < 0.5f ? Color::Red : Color::Blue;
+  });
+  Screen screen(2, 1);
+  Render(screen, element);
+  EXPECT_EQ(calls, 256);
+  EXPECT_EQ(screen.PixelAt(0, 0).foreground_color, Color(Color::Red));
+  EXPECT_EQ(screen.PixelAt(1, 0).foreground_color, Color(Color::Blue));
+}
+
+TEST(HeatmapTest, IncompleteRows) {
+  const float values[] = {0.f, 1.f, 2.f};
+  auto element = heatmap(values, 2, 4, Color::Red, Color::Blue);
+  Screen screen(2, 2);
+  Render(screen, element);
+  EXPECT_EQ(screen.PixelAt(0, 0).character, "▀");
+  EXPECT_EQ(screen.PixelAt(0, 1).character, " ");
+}
+
+TEST(HeatmapTest, NonFinite) {
+  const float inf = std::numeric_limits<float>::infinity();
+  const float values[] = {
+      0.f, std::numeric_limits<float>::quiet_NaN(), inf, -inf, 1.f,  //
+      -std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
+      0.f, 0.f, 0.f,  //
+  };
+  auto element = heatmap(values, 5, 2, Color::Black, Color::White);
+  Screen screen(5, 1);
+  Render(screen, element);
+  const Color low = Color::Interpolate(0.f, Color::Black, Color::White);
+  const Color high = Color::Interpolate(1.f, Color::Black, Color::White);
+  // The range ignores the non finite values.
+  EXPECT_EQ(screen.PixelAt(1, 0).foreground_color, low);
+  EXPECT_EQ(screen.PixelAt(2, 0).foreground_color, high);
+  EXPECT_EQ(screen.PixelAt(3, 0).foreground_color, low);
+  EXPECT_EQ(screen.PixelAt(0, 0).background_color, low);
+  EXPECT_EQ(screen.PixelAt(1, 0).background_color, high);
+}
+
+}  // namespace ftxui
+// NOLINTEND
@@ -0,0 +1,87 @@
+// Copyright 2020 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <gtest/gtest.h>
+#include <cstdint>  // for uint8_t
+#include <vector>   // for vector
+
+#include "ftxui/dom/elements.hpp"   // for image
+#include "ftxui/dom/node.hpp"       // for Render
+#include "ftxui/screen/color.hpp"   // for Color
+#include "ftxui/screen/screen.hpp"  // for Screen
+
+// NOLINTBEGIN
+namespace ftxui {
+
+namespace {
+std::vector<uint8_t> Checkerboard(int width, int height) {
+  std::vector<uint8_t> rgba;
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      const uint8_t value = (x + y) % 2 ? 200 : 0;
+      rgba.push_back(value);
+      rgba.push_back(value);
+      rgba.push_back(value);
+      rgba.push_back(255);
+    }
+  }
+  return rgba;
+}
+}  // namespace
+
+TEST(ImageTest, SameSize) {
+  // A 2x2 image, in one row of 2 characters.
+  std::vector<uint8_t> rgba = {
+      255, 0, 0, 255, /**/ 0, 255, 0, 255,  //
+      0, 0, 255, 255, /**/ 0, 0, 0, 0,      //
+  };
+  Screen screen(2, 1);
+  Render(screen, image(rgba, 2, 2));
+  EXPECT_EQ(screen.PixelAt(0, 0).character, "▀");
+  EXPECT_EQ(screen.PixelAt(0, 0).foreground_color, Color::RGB(255, 0, 0));
+  EXPECT_EQ(screen.PixelAt(0, 0).background_color, Color::RGB(0, 0, 255));
+  EXPECT_EQ(screen.PixelAt(1, 0).foreground_color, Color::RGB(0, 255, 0));
+  // Transparent.
+  EXPECT_EQ(screen.PixelAt(1, 0).background_color, Color());
+}
+
+TEST(ImageTest, Downscale) {
+  Screen screen(4, 2);
+  Render(screen, image(Checkerboard(40, 40), 40, 40));
+  for (int y = 0; y < 2; ++y) {
+    for (int x = 0; x < 4; ++x) {
+      EXPECT_EQ(screen.PixelAt(x, y).foreground_color,
+                Color::RGB(100, 100, 100));
+      EXPECT_EQ(screen.PixelAt(x, y).background_color,
+                Color::RGB(100, 100, 100));
+    }
+  }
+}
+
+TEST(ImageTest, Upscale) {
+  Screen screen(4, 2);
+  Render(screen, image(Checkerboard(2, 2), 2, 2));
+  EXPECT_EQ(screen.PixelAt(0, 0).foreground_color, Color::RGB(0, 0, 0));
+  EXPECT_EQ(screen.PixelAt(3, 0).foreground_color, Color::RGB(200, 200, 200));
+  EXPECT_EQ(screen.PixelAt(0, 1).background_color, Color::RGB(200, 200, 200));
+}
+
+TEST(ImageTest, InvalidSize) {
+  Screen screen(4, 2);
+  const uint8_t rgba[] = {1, 2, 3};
+  Render(screen, image(rgba, 2, 2));
+  EXPECT_EQ(screen.PixelAt(0, 0).character, " ");
+}
+
+TEST(ImageTest, NotCopied) {
+  // The element views the pixels of the caller.
+  std::vector<uint8_t> rgba = {10, 20, 30, 255};
+  auto element = image(rgba, 1, 1);
+  rgba[0] = 40;
+  Screen screen(1, 1);
+  Render(screen, element);
+  EXPECT_EQ(screen.PixelAt(0, 0).foreground_color, Color::RGB(40, 20, 30));
+}
+
+}  // namespace ftxui
+// NOLINTEND
@@ -0,0 +1,63 @@
+// Copyright 2023 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <string>  // for allocator, string
+
+#include "ftxui/dom/elements.hpp"  // for operator|, text, bold, dim, inverted, color, bgcolor, hyperlink, hbox, Element
+#include "ftxui/dom/node.hpp"       // for Render
+#include "ftxui/screen/color.hpp"   // for Color
+#include "ftxui/screen/screen.hpp"  // for Screen, Pixel
+#include "gtest/gtest.h"  // for Test, AssertionResult, EXPECT_TRUE, Message, TEST, TestPartResult
+
+// NOLINTBEGIN
+namespace ftxui {
+
+TEST(StyleNodeTest, Chain) {
+  auto element = text("text") | bold | dim | color(Color::Red) |
+                 bgcolor(Color::Blue) | inverted | hyperlink("https://a.com");
+  Screen screen(5, 1);
+  Render(screen, element);
+  const Pixel& pixel = screen.PixelAt(0, 0);
+  EXPECT_TRUE(pixel.bold);
+  EXPECT_TRUE(pixel.dim);
+  EXPECT_TRUE(pixel.inverted);
+  EXPECT_FALSE(pixel.blink);
+  EXPECT_EQ(pixel.foreground_color, Color(Color::Red));
+  EXPECT_EQ(pixel.background_color, Color(Color::Blue));
+  EXPECT_EQ(screen.Hyperlink(pixel.hyperlink), "https://a.com");
+}
+
+TEST(StyleNodeTest, InnermostColorWins) {
+  auto element = text("text") | color(Color::Red) | color(Color::Blue);
+  Screen screen(4, 1);
+  Render(screen, element);
+  EXPECT_EQ(screen.PixelAt(0, 0).foreground_color, Color(Color::Red));
+}
+
+TEST(StyleNodeTest, InvertedTwice) {
+  auto element = text("text") | inverted | bold | inverted;
+  Screen screen(4, 1);
+  Render(screen, element);
+  EXPECT_FALSE(screen.PixelAt(0, 0).inverted);
+  EXPECT_TRUE(screen.PixelAt(0, 0).bold);
+}
+
+TEST(StyleNodeTest, SharedChildIsNotModified) {
+  auto shared = text("a") | bold;
+  auto element = hbox({
+      shared | color(Color::Red),
+      text("b") | bold,
+  });
+  Screen screen(2, 1);
+  Render(screen, element);
+  EXPECT_EQ(screen.PixelAt(0, 0).foreground_color, Color(Color::Red));
+
+  Screen screen_shared(1, 1);
+  Render(screen_shared, shared);
+  EXPECT_TRUE(screen_shared.PixelAt(0, 0).bold);
+  EXPECT_EQ(screen_shared.PixelAt(0, 0).foreground_color,
+            Color(Color::Default));
+}
+
+}  // namespace ftxui
+// NOLINTEND
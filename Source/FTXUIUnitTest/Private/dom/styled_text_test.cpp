@@ -0,0 +1,89 @@
+// Copyright 2020 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <gtest/gtest.h>
+#include <string>  // for string
+#include <vector>  // for vector
+
+#include "ftxui/dom/elements.hpp"   // for styledText, styledParagraph
+#include "ftxui/dom/node.hpp"       // for Render
+#include "ftxui/screen/color.hpp"   // for Color
+#include "ftxui/screen/screen.hpp"  // for Screen, Pixel
+
+// NOLINTBEGIN
+namespace ftxui {
+
+namespace {
+StyleRun MakeRun(size_t begin, size_t end, uint8_t style) {
+  StyleRun run;
+  run.begin = begin;
+  run.end = end;
+  run.style = style;
+  return run;
+}
+}  // namespace
+
+TEST(StyledTextTest, Basic) {
+  StyleRun keyword = MakeRun(0, 6, Pixel::Bold);
+  keyword.foreground_color = Color::Blue;
+  StyleRun number = MakeRun(7, 8, 0);
+  number.background_color = Color::Red;
+
+  auto element = styledText("return 0;", {keyword, number});
+  Screen screen(12, 1);
+  Render(screen, element);
+  for (int x = 0; x < 9; ++x) {
+    EXPECT_EQ(screen.PixelAt(x, 0).character, std::string(1, "return 0;"[x]));
+    EXPECT_EQ(screen.PixelAt(x, 0).bold, x < 6);
+  }
+  EXPECT_EQ(screen.PixelAt(0, 0).foreground_color, Color(Color::Blue));
+  EXPECT_EQ(screen.PixelAt(6, 0).foreground_color, Color());
+  EXPECT_EQ(screen.PixelAt(7, 0).background_color, Color(Color::Red));
+  EXPECT_EQ(screen.PixelAt(8, 0).background_color, Color());
+  EXPECT_EQ(element->requirement().min_x, 9);
+}
+
+TEST(StyledTextTest, FullWidth) {
+  auto element = styledText("a测b", {MakeRun(1, 4, Pixel::Underlined)});
+  Screen screen(5, 1);
+  Render(screen, element);
+  EXPECT_FALSE(screen.PixelAt(0, 0).underlined);
+  EXPECT_TRUE(screen.PixelAt(1, 0).underlined);
+  EXPECT_TRUE(screen.PixelAt(2, 0).underlined);
+  EXPECT_FALSE(screen.PixelAt(3, 0).underlined);
+  EXPECT_EQ(screen.PixelAt(3, 0).character, "b");
+}
+
+TEST(StyledTextTest, Clipped) {
+  auto element = styledText("abcdef", {MakeRun(0, 6, Pixel::Bold)});
+  Screen screen(3, 1);
+  Render(screen, element);
+  EXPECT_EQ(screen.ToString(), "\x1B[1mabc\x1B[22m");
+}
+
+TEST(StyledTextTest, Paragraph) {
+  auto element =
+      styledParagraph("hello big world\nnew", {MakeRun(6, 9, Pixel::Bold)});
+  Screen screen(10, 5);
+  Render(screen, element);
+  EXPECT_EQ(screen.ToString(),
+            "hello \x1B[1mbig\x1B[22m \r\n"
+            "world     \r\n"
+            "new       \r\n"
+            "          \r\n"
+            "          ");
+}
+
+TEST(StyledTextTest, ParagraphHardBreak) {
+  auto element = vbox({styledParagraph("abcdefgh", {}), text("x")});
+  Screen screen(3, 4);
+  Render(screen, element);
+  EXPECT_EQ(screen.ToString(),
+            "abc\r\n"
+            "def\r\n"
+            "gh \r\n"
+            "x  ");
+}
+
+}  // namespace ftxui
+// NOLINTEND
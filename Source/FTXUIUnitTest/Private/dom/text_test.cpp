@@ -2,9 +2,11 @@
 // Use of this source code is governed by the MIT license that can be found in
 // the LICENSE file.
 #include <gtest/gtest.h>
-#include <string>  // for allocator, string
+#include <memory>       // for make_shared
+#include <string>       // for allocator, string
+#include <string_view>  // for string_view
 
-#include "ftxui/dom/elements.hpp"   // for text, operator|, border, Element
+#include "ftxui/dom/elements.hpp"   // for text, text_view, operator|, border, Element
 #include "ftxui/dom/node.hpp"       // for Render
 #include "ftxui/screen/screen.hpp"  // for Screen
 
@@ -121,5 +123,47 @@ TEST(TextTest, CombiningCharactersWithSpace) {
   EXPECT_EQ(t, screen.ToString());
 }
 
+TEST(TextTest, View) {
+  const std::string buffer = "hello world";
+  auto element = text_view(std::string_view(buffer).substr(6));
+  Screen screen(7, 1);
+  Render(screen, element);
+  EXPECT_EQ("world  ", screen.ToString());
+  EXPECT_EQ(element->requirement().min_x, 5);
+}
+
+TEST(TextTest, Shared) {
+  auto buffer = std::make_shared<const std::string>("测试");
+  for (int i = 0; i < 2; ++i) {
+    auto element = text(buffer) | border;
+    Screen screen(6, 3);
+    Render(screen, element);
+    EXPECT_EQ(
+        "╭────╮\r\n"
+        "│测试│\r\n"
+        "╰────╯",
+        screen.ToString());
+  }
+
+  // A new buffer of the same length is measured again, even if it reuses the
+  // same address.
+  buffer.reset();
+  buffer = std::make_shared<const std::string>("abcdef");
+  auto element = text(buffer);
+  Screen screen(6, 1);
+  Render(screen, element);
+  EXPECT_EQ(element->requirement().min_x, 6);
+  EXPECT_EQ("abcdef", screen.ToString());
+}
+
+TEST(TextTest, LongTextClipped) {
+  const std::string buffer(1 << 20, 'a');
+  auto element = text_view(buffer);
+  Screen screen(4, 1);
+  Render(screen, element);
+  EXPECT_EQ("aaaa", screen.ToString());
+  EXPECT_EQ(element->requirement().min_x, 1 << 20);
+}
+
 }  // namespace ftxui
 // NOLINTEND
@@ -0,0 +1,92 @@
+// Copyright 2020 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <gtest/gtest.h>
+#include <algorithm>  // for max, min
+#include <memory>     // for make_shared
+#include <thread>     // for thread
+#include <vector>     // for vector
+
+#include "ftxui/dom/elements.hpp"     // for graph
+#include "ftxui/dom/node.hpp"         // for Render
+#include "ftxui/dom/time_series.hpp"  // for TimeSeries
+#include "ftxui/screen/screen.hpp"    // for Screen
+
+// NOLINTBEGIN
+namespace ftxui {
+
+TEST(TimeSeriesTest, MinMax) {
+  TimeSeries series(1000);  // Rounded up to 1024.
+  std::vector<float> values;
+  for (int i = 0; i < 3000; ++i) {
+    values.push_back(float((i * 7919) % 1013));
+    series.Push(values.back());
+  }
+  EXPECT_EQ(series.size(), 1024u);
+
+  const size_t oldest = values.size() - 1024;
+  for (size_t first : {0, 1, 17, 500, 1000}) {
+    for (size_t last : {1001, 1010, 1024}) {
+      float min = 0.f;
+      float max = 0.f;
+      series.MinMax(first, last, &min, &max);
+      EXPECT_EQ(min, *std::min_element(values.begin() + oldest + first,
+                                       values.begin() + oldest + last));
+      EXPECT_EQ(max, *std::max_element(values.begin() + oldest + first,
+                                       values.begin() + oldest + last));
+    }
+  }
+}
+
+TEST(TimeSeriesTest, Sample) {
+  TimeSeries series(16);
+  for (int i = 0; i < 8; ++i) {
+    series.Push(float(i));
+  }
+  EXPECT_EQ(series.Sample(4, 7), (std::vector<int>{1, 3, 5, 7}));
+  EXPECT_EQ(series.Sample(10, 7),
+            (std::vector<int>{0, 0, 0, 1, 2, 3, 4, 5, 6, 7}));
+
+  series.SetWindow(4);
+  series.SetRange(0.f, 14.f);
+  EXPECT_EQ(series.Sample(2, 7), (std::vector<int>{3, 4}));
+}
+
+TEST(TimeSeriesTest, ConcurrentProducers) {
+  auto series = std::make_shared<TimeSeries>(1 << 12);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&] {
+      for (int i = 0; i < 10000; ++i) {
+        series->Push(1.f);
+      }
+    });
+  }
+
+  Screen screen(10, 5);
+  for (int frame = 0; frame < 10; ++frame) {
+    Render(screen, graph(series));
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // Whatever the interleaving, the ring holds the most recent samples once
+  // the producers are done.
+  EXPECT_EQ(series->size(), size_t(1 << 12));
+  float min = 0.f;
+  float max = 0.f;
+  series->MinMax(0, series->size(), &min, &max);
+  EXPECT_EQ(min, 1.f);
+  EXPECT_EQ(max, 1.f);
+
+  // A new sample is consumed right away.
+  series->Push(2.f);
+  EXPECT_EQ(series->size(), size_t(1 << 12));
+  series->MinMax(series->size() - 1, series->size(), &min, &max);
+  EXPECT_EQ(min, 2.f);
+  EXPECT_EQ(max, 2.f);
+}
+
+}  // namespace ftxui
+// NOLINTEND
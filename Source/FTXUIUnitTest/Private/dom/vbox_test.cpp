@@ -4,10 +4,11 @@
 #include <gtest/gtest.h>
 #include <algorithm>  // for remove
 #include <cstddef>    // for size_t
+#include <memory>     // for make_shared
 #include <string>     // for string, allocator, basic_string
 #include <vector>     // for vector
 
-#include "ftxui/dom/elements.hpp"  // for vtext, operator|, vbox, Element, flex_grow, flex_shrink
+#include "ftxui/dom/elements.hpp"  // for vtext, operator|, vbox, Element, flex_grow, flex_shrink, frame, focus
 #include "ftxui/dom/node.hpp"       // for Render
 #include "ftxui/screen/screen.hpp"  // for Screen
 
@@ -368,5 +369,34 @@ TEST(VBoxText, FlexGrow_NoFlex_FlewShrink) {
   }
 }
 
+TEST(VBoxText, CullInvisibleChildren) {
+  class CountRender : public Node {
+   public:
+    explicit CountRender(int* count) : count_(count) {}
+    void ComputeRequirement() override {
+      requirement_.min_x = 1;
+      requirement_.min_y = 1;
+    }
+    void Render(Screen& screen) override {
+      ++*count_;
+      screen.at(box_.x_min, box_.y_min) = "x";
+    }
+    int* count_;
+  };
+
+  int count = 0;
+  Elements children;
+  for (int i = 0; i < 1000; ++i) {
+    children.push_back(std::make_shared<CountRender>(&count));
+  }
+  children[500] = children[500] | focus;
+  auto root = vbox(std::move(children)) | frame;
+
+  Screen screen(1, 10);
+  Render(screen, root);
+  EXPECT_EQ(count, 10);
+  EXPECT_EQ(rotate(screen.ToString()), "xxxxxxxxxx");
+}
+
 }  // namespace ftxui
 // NOLINTEND
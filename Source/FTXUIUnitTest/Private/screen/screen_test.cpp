@@ -0,0 +1,81 @@
+// Copyright 2023 Arthur Sonzogni. All rights reserved.
+// Use of this source code is governed by the MIT license that can be found in
+// the LICENSE file.
+#include <gtest/gtest.h>
+#include <string>  // for allocator, string
+#include <vector>  // for vector
+
+#include "ftxui/screen/box.hpp"     // for Box
+#include "ftxui/screen/color.hpp"   // for Color, Color::Red
+#include "ftxui/screen/screen.hpp"  // for Screen, Pixel
+
+// NOLINTBEGIN
+namespace ftxui {
+
+TEST(ScreenTest, FillStyle) {
+  Screen screen(4, 3);
+  screen.stencil = Box{0, 2, 0, 1};
+  screen.FillStyle(Box{1, 3, 1, 2}, Pixel::Bold | Pixel::Dim, Pixel::Bold);
+  screen.stencil = Box{0, 3, 0, 2};
+
+  EXPECT_FALSE(screen.PixelAt(0, 1).bold);
+  EXPECT_TRUE(screen.PixelAt(1, 1).bold);
+  EXPECT_TRUE(screen.PixelAt(2, 1).bold);
+  EXPECT_FALSE(screen.PixelAt(1, 1).dim);
+  // Outside of the stencil:
+  EXPECT_FALSE(screen.PixelAt(3, 1).bold);
+  EXPECT_FALSE(screen.PixelAt(1, 2).bold);
+
+  screen.FillStyle(Box{0, 3, 0, 2}, Pixel::Bold, 0);
+  EXPECT_FALSE(screen.PixelAt(1, 1).bold);
+}
+
+TEST(ScreenTest, ToggleStyle) {
+  Screen screen(3, 1);
+  screen.PixelAt(1, 0).inverted = true;
+  screen.ToggleStyle(Box{0, 2, 0, 0}, Pixel::Inverted);
+  EXPECT_TRUE(screen.PixelAt(0, 0).inverted);
+  EXPECT_FALSE(screen.PixelAt(1, 0).inverted);
+  EXPECT_TRUE(screen.PixelAt(2, 0).inverted);
+}
+
+TEST(ScreenTest, FillColor) {
+  Screen screen(3, 2);
+  screen.FillColor(Box{1, 5, 1, 5}, Color::Red, /*background=*/true);
+  screen.FillColor(Box{-2, 0, 0, 0}, Color::Blue, /*background=*/false);
+  EXPECT_EQ(screen.PixelAt(1, 1).background_color, Color(Color::Red));
+  EXPECT_EQ(screen.PixelAt(2, 1).background_color, Color(Color::Red));
+  EXPECT_EQ(screen.PixelAt(0, 1).background_color, Color(Color::Default));
+  EXPECT_EQ(screen.PixelAt(0, 0).foreground_color, Color(Color::Blue));
+  EXPECT_EQ(screen.PixelAt(1, 0).foreground_color, Color(Color::Default));
+}
+
+TEST(ScreenTest, WriteRun) {
+  Screen screen(5, 1);
+  screen.stencil = Box{1, 4, 0, 0};
+  screen.WriteRun(0, 0, {"a", "b", "\n", "c", "d", "e"}, 3);
+  screen.stencil = Box{0, 4, 0, 0};
+  EXPECT_EQ(screen.ToString(), " bcd ");
+}
+
+TEST(ScreenTest, ForEachRow) {
+  Screen screen(3, 3);
+  int cells = 0;
+  int rows = 0;
+  screen.ForEachRow(Box{1, 10, -1, 1}, [&](Pixel* begin, Pixel* end) {
+    ++rows;
+    cells += int(end - begin);
+    for (Pixel* pixel = begin; pixel != end; ++pixel) {
+      pixel->character = "x";
+    }
+  });
+  EXPECT_EQ(rows, 2);
+  EXPECT_EQ(cells, 4);
+  EXPECT_EQ(screen.ToString(),
+            " xx\r\n"
+            " xx\r\n"
+            "   ");
+}
+
+}  // namespace ftxui
+// NOLINTEND
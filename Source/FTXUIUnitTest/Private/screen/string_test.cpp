@@ -65,6 +65,36 @@ TEST(StringTest, GlyphCount) {
   EXPECT_EQ(GlyphCount("a\1a"), 2);
 }
 
+TEST(StringTest, MeasureText) {
+  for (const std::string t : {"", "a", "ab", "测试", "ā", "a⃒", "\1", "a\1a",
+                              "a somewhat longer label", "测试 测试 测试"}) {
+    EXPECT_EQ(MeasureText(t).width, string_width(t));
+    EXPECT_EQ(MeasureText(t).glyphs, GlyphCount(t));
+  }
+}
+
+TEST(StringTest, MeasureTextCache) {
+  ResetTextMetricsStats();
+  MeasureText("short");
+  MeasureText("测试 MeasureTextCache");
+  MeasureText("测试 MeasureTextCache");
+  TextMetricsStats stats = GetTextMetricsStats();
+  EXPECT_EQ(stats.inlined, 1u);
+  EXPECT_EQ(stats.misses, 1u);
+  EXPECT_EQ(stats.hits, 1u);
+
+  // The least recently used strings are evicted.
+  for (int i = 0; i < 2000; ++i) {
+    MeasureText("测试 " + std::to_string(i));
+  }
+  stats = GetTextMetricsStats();
+  EXPECT_GE(stats.evictions, 2001u - 1024u);
+  MeasureText("测试 1999");
+  EXPECT_EQ(GetTextMetricsStats().hits, stats.hits + 1);
+  MeasureText("测试 MeasureTextCache");
+  EXPECT_EQ(GetTextMetricsStats().misses, stats.misses + 1);
+}
+
 TEST(StringTest, GlyphIterate) {
   // Basic:
   EXPECT_EQ(GlyphIterate("", -1), 0);